@@ -0,0 +1,166 @@
+
+#include "Commandlets/CompileBlueprintsParallelCommandlet.h"
+
+// AssetRegistry
+#include "AssetRegistry/AssetRegistryModule.h"
+
+// Engine
+#include "Engine/Blueprint.h"
+
+// UnrealEd
+#include "Kismet2/CompilerResultsLog.h"
+#include "Kismet2/KismetEditorUtilities.h"
+
+DEFINE_LOG_CATEGORY_STATIC( LogCompileBlueprintsParallel, Log, All );
+
+// How many Blueprints a worker compiles before cleaning up the garbage created by the compiles
+static constexpr int32 GarbageCollectInterval = 100;
+
+// Rough amount of memory that each worker needs, every one of them is a full editor process with the project loaded
+static constexpr uint32 WorkerMemoryGB = 4;
+
+UCompileBlueprintsParallelCommandlet::UCompileBlueprintsParallelCommandlet( )
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UCompileBlueprintsParallelCommandlet::Main( const FString &Params )
+{
+	FString Path;
+	FParse::Value( *Params, TEXT( "Path=" ), Path );
+
+	// The kismet compiler isn't able to run off the game thread (it creates and destroys UObjects the entire time)
+	// so the parallelism comes from giving each worker process its own share of the Blueprints instead
+	int32 ShardIndex = INDEX_NONE;
+	int32 ShardCount = 0;
+	if (FParse::Value( *Params, TEXT( "ShardIndex=" ), ShardIndex ) && FParse::Value( *Params, TEXT( "ShardCount=" ), ShardCount ))
+		return RunWorker( ShardIndex, ShardCount, Path );
+
+	// By default use every core, but only as many workers as there is memory for
+	const auto MemoryLimitedWorkers = (int32)(FPlatformMemory::GetConstants( ).TotalPhysicalGB / WorkerMemoryGB);
+	int32 WorkerCount = FMath::Max( FMath::Min( FPlatformMisc::NumberOfCores( ), MemoryLimitedWorkers ), 1 );
+	FParse::Value( *Params, TEXT( "Workers=" ), WorkerCount );
+
+	if (WorkerCount <= 1)
+		return RunWorker( 0, 1, Path );
+
+	return RunCoordinator( WorkerCount, Path );
+}
+
+int32 UCompileBlueprintsParallelCommandlet::RunCoordinator( int32 WorkerCount, const FString &Path ) const
+{
+	UE_LOG( LogCompileBlueprintsParallel, Display, TEXT( "Compiling Blueprints with %d worker processes" ), WorkerCount );
+
+	TArray< FProcHandle > Workers;
+	for (int idx = 0; idx < WorkerCount; ++idx)
+	{
+		auto WorkerParams = FString::Printf( TEXT( "\"%s\" -run=CompileBlueprintsParallel -ShardIndex=%d -ShardCount=%d -unattended -nopause -nosplash -NullRHI" ), *FPaths::GetProjectFilePath( ), idx, WorkerCount );
+		if (!Path.IsEmpty( ))
+			WorkerParams += FString::Printf( TEXT( " -Path=\"%s\"" ), *Path );
+
+		auto Handle = FPlatformProcess::CreateProc( FPlatformProcess::ExecutablePath( ), *WorkerParams, true, false, false, nullptr, 0, nullptr, nullptr );
+		if (!Handle.IsValid( ))
+		{
+			UE_LOG( LogCompileBlueprintsParallel, Error, TEXT( "Failed to launch worker %d" ), idx );
+			continue;
+		}
+
+		Workers.Add( Handle );
+	}
+
+	const int32 UnlaunchedWorkers = WorkerCount - Workers.Num( );
+
+	int32 FailedWorkers = 0;
+	for (auto &Handle : Workers)
+	{
+		FPlatformProcess::WaitForProc( Handle );
+
+		int32 ReturnCode = 0;
+		if (!FPlatformProcess::GetProcReturnCode( Handle, &ReturnCode ) || (ReturnCode != 0))
+			++FailedWorkers;
+
+		FPlatformProcess::CloseProc( Handle );
+	}
+
+	if (UnlaunchedWorkers > 0)
+		UE_LOG( LogCompileBlueprintsParallel, Error, TEXT( "%d of %d workers failed to launch, their share of the Blueprints wasn't compiled" ), UnlaunchedWorkers, WorkerCount );
+
+	if (FailedWorkers > 0)
+		UE_LOG( LogCompileBlueprintsParallel, Error, TEXT( "%d of %d workers reported Blueprint compile errors" ), FailedWorkers, WorkerCount );
+
+	if ((UnlaunchedWorkers > 0) || (FailedWorkers > 0))
+		return 1;
+
+	UE_LOG( LogCompileBlueprintsParallel, Display, TEXT( "All Blueprints compiled successfully" ) );
+	return 0;
+}
+
+int32 UCompileBlueprintsParallelCommandlet::RunWorker( int32 ShardIndex, int32 ShardCount, const FString &Path ) const
+{
+	if ((ShardCount <= 0) || (ShardIndex < 0) || (ShardIndex >= ShardCount))
+	{
+		UE_LOG( LogCompileBlueprintsParallel, Error, TEXT( "Invalid shard %d of %d" ), ShardIndex, ShardCount );
+		return 1;
+	}
+
+	const auto Assets = GatherBlueprints( Path );
+
+	int32 Compiled = 0;
+	int32 Failed = 0;
+
+	for (int idx = ShardIndex; idx < Assets.Num( ); idx += ShardCount)
+	{
+		const auto Blueprint = Cast< UBlueprint >( Assets[ idx ].GetAsset( ) );
+		if (Blueprint == nullptr)
+			continue;
+
+		FCompilerResultsLog Results;
+		Results.SetSourcePath( Blueprint->GetPathName( ) );
+		Results.BeginEvent( TEXT( "Compile" ) );
+		FKismetEditorUtilities::CompileBlueprint( Blueprint, EBlueprintCompileOptions::SkipGarbageCollection, &Results );
+		Results.EndEvent( );
+
+		++Compiled;
+		if (Results.NumErrors > 0)
+		{
+			++Failed;
+			UE_LOG( LogCompileBlueprintsParallel, Error, TEXT( "%s failed to compile with %d error(s)" ), *Blueprint->GetPathName( ), Results.NumErrors );
+
+			for (const auto &Message : Results.Messages)
+				UE_LOG( LogCompileBlueprintsParallel, Error, TEXT( "    %s" ), *Message->ToText( ).ToString( ) );
+		}
+
+		if ((Compiled % GarbageCollectInterval) == 0)
+			CollectGarbage( RF_NoFlags );
+	}
+
+	UE_LOG( LogCompileBlueprintsParallel, Display, TEXT( "Shard %d of %d compiled %d Blueprints, %d failed" ), ShardIndex, ShardCount, Compiled, Failed );
+
+	return (Failed > 0) ? 1 : 0;
+}
+
+TArray< FAssetData > UCompileBlueprintsParallelCommandlet::GatherBlueprints( const FString &Path ) const
+{
+	auto &AssetRegistry = FModuleManager::LoadModuleChecked< FAssetRegistryModule >( TEXT( "AssetRegistry" ) ).Get( );
+	AssetRegistry.SearchAllAssets( true );
+
+	FARFilter Filter;
+	Filter.ClassPaths.Add( UBlueprint::StaticClass( )->GetClassPathName( ) );
+	Filter.bRecursiveClasses = true;
+
+	if (!Path.IsEmpty( ))
+	{
+		Filter.PackagePaths.Add( FName( *Path ) );
+		Filter.bRecursivePaths = true;
+	}
+
+	TArray< FAssetData > Assets;
+	AssetRegistry.GetAssets( Filter, Assets );
+
+	Assets.Sort( []( const FAssetData &A, const FAssetData &B ) { return A.PackageName.LexicalLess( B.PackageName ); } );
+
+	return Assets;
+}
@@ -0,0 +1,32 @@
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+
+#include "CompileBlueprintsParallelCommandlet.generated.h"
+
+struct FAssetData;
+
+// Compile and validate every Blueprint in the project, sharding the work across worker processes so that every core is used.
+// The default number of workers is limited by the physical memory as well as the number of cores.
+// Usage: -run=CompileBlueprintsParallel [-Workers=N] [-Path=/Game/Some/Folder]
+UCLASS( )
+class CORETECHDEVELOPER_API UCompileBlueprintsParallelCommandlet : public UCommandlet
+{
+	GENERATED_BODY( )
+public:
+	UCompileBlueprintsParallelCommandlet( );
+
+	// Commandlet API
+	int32 Main( const FString &Params ) override;
+
+private:
+	// Launch the worker processes and wait for all of them to report back
+	UE_NODISCARD int32 RunCoordinator( int32 WorkerCount, const FString &Path ) const;
+
+	// Compile the share of the Blueprints assigned to this worker
+	UE_NODISCARD int32 RunWorker( int32 ShardIndex, int32 ShardCount, const FString &Path ) const;
+
+	// Find all the Blueprint assets, in a stable order so that every worker agrees on how they are sharded
+	UE_NODISCARD TArray< FAssetData > GatherBlueprints( const FString &Path ) const;
+};
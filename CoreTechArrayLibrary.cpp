@@ -0,0 +1,652 @@
+#include "CoreTechArrayLibrary.h"
+
+// Core
+#include "Math/VectorRegister.h"
+
+// CoreUObject
+#include "UObject/UnrealType.h"
+
+namespace CoreTechArrayLibrary
+{
+	// The name that the Blueprint compiler gives to the world context parameter it adds to the functions of Blueprint function libraries
+	static const FName BlueprintWorldContextName( TEXT( "__WorldContext" ) );
+
+	// Find the member of the struct that a projection pin was created for and make sure it matches what the pin expects
+	static const FProperty* FindMember( const FProperty *ContainerInner, FName MemberName, const FProperty *ValueProperty )
+	{
+		const auto StructProperty = CastField< FStructProperty >( ContainerInner );
+		if (StructProperty == nullptr)
+			return nullptr;
+
+		const auto Member = FindFProperty< FProperty >( StructProperty->Struct, MemberName );
+		if ((Member == nullptr) || (ValueProperty == nullptr) || !Member->SameType( ValueProperty ))
+			return nullptr;
+
+		return Member;
+	}
+
+	// Whether an array element can be passed directly as the value of a function parameter
+	static bool IsElementCompatibleWithParam( const FProperty *Inner, const FProperty *Param )
+	{
+		if (Param->SameType( Inner ))
+			return true;
+
+		// Predicates are allowed to take a base class of the array elements
+		const auto InnerObject = CastField< FObjectPropertyBase >( Inner );
+		const auto ParamObject = CastField< FObjectPropertyBase >( Param );
+		return (InnerObject != nullptr) && (ParamObject != nullptr) && (InnerObject->GetClass( ) == ParamObject->GetClass( )) &&
+			InnerObject->PropertyClass->IsChildOf( ParamObject->PropertyClass );
+	}
+
+	// Call the predicate function for each element of the array until Visit returns false. The parameters are set up once
+	// for the whole scan instead of once per element, the way a loop in the Blueprint VM would have to.
+	// Returns false (after reporting why) if the predicate can't be called with the elements of the array.
+	template < typename TVisitor >
+	static bool ScanWithPredicate( UObject *WorldContextObject, const void *TargetArray, const FArrayProperty *ArrayProperty, UObject *Target, FName PredicateName, TVisitor Visit )
+	{
+		if ((TargetArray == nullptr) || (Target == nullptr))
+			return false;
+
+		const auto Predicate = Target->FindFunction( PredicateName );
+
+		FProperty *ElementParam = nullptr;
+		FProperty *ResultParam = nullptr;
+		FObjectPropertyBase *WorldContextParam = nullptr;
+		const bool bValidParams = UCoreTechArrayLibrary::FindPredicateParams( Predicate, ElementParam, ResultParam, WorldContextParam );
+
+		const auto ReturnParam = CastField< FBoolProperty >( ResultParam );
+		if (!bValidParams || (ReturnParam == nullptr) || !IsElementCompatibleWithParam( ArrayProperty->Inner, ElementParam ))
+		{
+			FFrame::KismetExecutionMessage( *FString::Printf( TEXT( "Predicate '%s' of '%s' can't be used to test the elements of array '%s'." ), *PredicateName.ToString( ), *Target->GetName( ), *ArrayProperty->GetName( ) ), ELogVerbosity::Warning );
+			return false;
+		}
+
+		uint8 *Params = (uint8*)FMemory_Alloca_Aligned( Predicate->ParmsSize, Predicate->GetMinAlignment( ) );
+		FMemory::Memzero( Params, Predicate->ParmsSize );
+		for (TFieldIterator< FProperty > It( Predicate ); It && It->HasAnyPropertyFlags( CPF_Parm ); ++It)
+			It->InitializeValue_InContainer( Params );
+
+		if (WorldContextParam != nullptr)
+			WorldContextParam->SetObjectPropertyValue_InContainer( Params, WorldContextObject );
+
+		const auto ElementValue = ElementParam->ContainerPtrToValuePtr< void >( Params );
+
+		FScriptArrayHelper ArrayHelper( ArrayProperty, TargetArray );
+		for (int idx = 0; idx < ArrayHelper.Num( ); ++idx)
+		{
+			ElementParam->CopyCompleteValue( ElementValue, ArrayHelper.GetRawPtr( idx ) );
+			Target->ProcessEvent( Predicate, Params );
+
+			if (!Visit( idx, ReturnParam->GetPropertyValue_InContainer( Params ) ))
+				break;
+		}
+
+		for (TFieldIterator< FProperty > It( Predicate ); It && It->HasAnyPropertyFlags( CPF_Parm ); ++It)
+			It->DestroyValue_InContainer( Params );
+
+		return true;
+	}
+
+	// Wrappers that let the reduction kernels be written once for each of the SIMD register types
+	template < typename T >
+	struct TSimd;
+
+	template < >
+	struct TSimd< int32 >
+	{
+		using Register = VectorRegister4Int;
+
+		static Register Load( const int32 *Ptr ) { return VectorIntLoad( Ptr ); }
+		static Register Splat( int32 Value ) { return MakeVectorRegisterInt( Value, Value, Value, Value ); }
+		static void Store( const Register &V, int32 *Ptr ) { VectorIntStore( V, Ptr ); }
+
+		static Register Add( const Register &A, const Register &B ) { return VectorIntAdd( A, B ); }
+		static Register MultiplyAdd( const Register &A, const Register &B, const Register &Acc ) { return VectorIntAdd( VectorIntMultiply( A, B ), Acc ); }
+		static Register Min( const Register &A, const Register &B ) { return VectorIntMin( A, B ); }
+		static Register Max( const Register &A, const Register &B ) { return VectorIntMax( A, B ); }
+	};
+
+	template < >
+	struct TSimd< float >
+	{
+		using Register = VectorRegister4Float;
+
+		static Register Load( const float *Ptr ) { return VectorLoad( Ptr ); }
+		static Register Splat( float Value ) { return MakeVectorRegisterFloat( Value, Value, Value, Value ); }
+		static void Store( const Register &V, float *Ptr ) { VectorStore( V, Ptr ); }
+
+		static Register Add( const Register &A, const Register &B ) { return VectorAdd( A, B ); }
+		static Register MultiplyAdd( const Register &A, const Register &B, const Register &Acc ) { return VectorMultiplyAdd( A, B, Acc ); }
+		static Register Min( const Register &A, const Register &B ) { return VectorMin( A, B ); }
+		static Register Max( const Register &A, const Register &B ) { return VectorMax( A, B ); }
+	};
+
+	template < >
+	struct TSimd< double >
+	{
+		using Register = VectorRegister4Double;
+
+		static Register Load( const double *Ptr ) { return VectorLoad( Ptr ); }
+		static Register Splat( double Value ) { return MakeVectorRegisterDouble( Value, Value, Value, Value ); }
+		static void Store( const Register &V, double *Ptr ) { VectorStore( V, Ptr ); }
+
+		static Register Add( const Register &A, const Register &B ) { return VectorAdd( A, B ); }
+		static Register MultiplyAdd( const Register &A, const Register &B, const Register &Acc ) { return VectorMultiplyAdd( A, B, Acc ); }
+		static Register Min( const Register &A, const Register &B ) { return VectorMin( A, B ); }
+		static Register Max( const Register &A, const Register &B ) { return VectorMax( A, B ); }
+	};
+
+	// Integer arithmetic for the scalar parts of the reductions. This wraps around on overflow the same way that
+	// the integer vector lanes do, instead of being undefined.
+	template < typename T >
+	static T ScalarAdd( T A, T B )
+	{
+		if constexpr (std::is_integral_v< T >)
+			return T( std::make_unsigned_t< T >( A ) + std::make_unsigned_t< T >( B ) );
+		else
+			return A + B;
+	}
+
+	template < typename T >
+	static T ScalarMultiply( T A, T B )
+	{
+		if constexpr (std::is_integral_v< T >)
+			return T( std::make_unsigned_t< T >( A ) * std::make_unsigned_t< T >( B ) );
+		else
+			return A * B;
+	}
+
+	// Number of elements consumed per iteration of the vectorized loops. Two registers are used so that the
+	// loop isn't stalled waiting on the result of the previous add.
+	static constexpr int32 SimdWidth = 4;
+	static constexpr int32 SimdStride = SimdWidth * 2;
+
+	template < typename T, typename TVectorOp, typename TScalarOp >
+	static T Reduce( const T *Data, int32 Num, T Identity, TVectorOp VectorOp, TScalarOp ScalarOp )
+	{
+		using FSimd = TSimd< T >;
+
+		auto Acc0 = FSimd::Splat( Identity );
+		auto Acc1 = FSimd::Splat( Identity );
+
+		int32 idx = 0;
+		for (; idx + SimdStride <= Num; idx += SimdStride)
+		{
+			Acc0 = VectorOp( Acc0, FSimd::Load( Data + idx ) );
+			Acc1 = VectorOp( Acc1, FSimd::Load( Data + idx + SimdWidth ) );
+		}
+		for (; idx + SimdWidth <= Num; idx += SimdWidth)
+		{
+			Acc0 = VectorOp( Acc0, FSimd::Load( Data + idx ) );
+		}
+
+		alignas( 32 ) T Lanes[ SimdWidth ];
+		FSimd::Store( VectorOp( Acc0, Acc1 ), Lanes );
+
+		auto Result = Identity;
+		for (const auto Lane : Lanes)
+			Result = ScalarOp( Result, Lane );
+
+		for (; idx < Num; ++idx)
+			Result = ScalarOp( Result, Data[ idx ] );
+
+		return Result;
+	}
+
+	template < typename T >
+	static T Sum( const TArray< T > &Array )
+	{
+		return Reduce( Array.GetData( ), Array.Num( ), T( 0 ), &TSimd< T >::Add, &ScalarAdd< T > );
+	}
+
+	template < typename T >
+	static T Min( const TArray< T > &Array )
+	{
+		if (Array.Num( ) == 0)
+			return T( 0 );
+
+		// Seed with an element so that the identity can't influence the result
+		return Reduce( Array.GetData( ), Array.Num( ), Array[ 0 ], &TSimd< T >::Min, []( T A, T B ) { return FMath::Min( A, B ); } );
+	}
+
+	template < typename T >
+	static T Max( const TArray< T > &Array )
+	{
+		if (Array.Num( ) == 0)
+			return T( 0 );
+
+		// Seed with an element so that the identity can't influence the result
+		return Reduce( Array.GetData( ), Array.Num( ), Array[ 0 ], &TSimd< T >::Max, []( T A, T B ) { return FMath::Max( A, B ); } );
+	}
+
+	template < typename T >
+	static double Average( const TArray< T > &Array )
+	{
+		if (Array.Num( ) == 0)
+			return 0.0;
+
+		// The mean of integers is always in range even when their sum isn't, so total them without wrapping
+		if constexpr (std::is_integral_v< T >)
+		{
+			int64 Total = 0;
+			for (const auto Value : Array)
+				Total += Value;
+
+			return double( Total ) / Array.Num( );
+		}
+		else
+		{
+			return double( Sum( Array ) ) / Array.Num( );
+		}
+	}
+
+	template < typename T >
+	static T Dot( const TArray< T > &A, const TArray< T > &B )
+	{
+		using FSimd = TSimd< T >;
+
+		if (A.Num( ) != B.Num( ))
+			FFrame::KismetExecutionMessage( *FString::Printf( TEXT( "Dot product of arrays with different lengths [%d/%d], extra elements are ignored." ), A.Num( ), B.Num( ) ), ELogVerbosity::Warning );
+
+		const auto Num = FMath::Min( A.Num( ), B.Num( ) );
+		const auto DataA = A.GetData( );
+		const auto DataB = B.GetData( );
+
+		auto Acc0 = FSimd::Splat( T( 0 ) );
+		auto Acc1 = FSimd::Splat( T( 0 ) );
+
+		int32 idx = 0;
+		for (; idx + SimdStride <= Num; idx += SimdStride)
+		{
+			Acc0 = FSimd::MultiplyAdd( FSimd::Load( DataA + idx ), FSimd::Load( DataB + idx ), Acc0 );
+			Acc1 = FSimd::MultiplyAdd( FSimd::Load( DataA + idx + SimdWidth ), FSimd::Load( DataB + idx + SimdWidth ), Acc1 );
+		}
+		for (; idx + SimdWidth <= Num; idx += SimdWidth)
+		{
+			Acc0 = FSimd::MultiplyAdd( FSimd::Load( DataA + idx ), FSimd::Load( DataB + idx ), Acc0 );
+		}
+
+		alignas( 32 ) T Lanes[ SimdWidth ];
+		FSimd::Store( FSimd::Add( Acc0, Acc1 ), Lanes );
+
+		auto Result = T( 0 );
+		for (const auto Lane : Lanes)
+			Result = ScalarAdd( Result, Lane );
+
+		for (; idx < Num; ++idx)
+			Result = ScalarAdd( Result, ScalarMultiply( DataA[ idx ], DataB[ idx ] ) );
+
+		return Result;
+	}
+}
+
+int32 UCoreTechArrayLibrary::GenericArray_NextValidIndex( const void *TargetArray, const FArrayProperty *ArrayProperty, int32 StartIndex )
+{
+	if (TargetArray == nullptr)
+		return 0;
+
+	FScriptArrayHelper ArrayHelper( ArrayProperty, TargetArray );
+	const auto Num = ArrayHelper.Num( );
+
+	// Resolve the element type once instead of for every element
+	if (CastField< FSoftObjectProperty >( ArrayProperty->Inner ) != nullptr)
+	{
+		for (int idx = FMath::Max( StartIndex, 0 ); idx < Num; ++idx)
+		{
+			// A soft reference that isn't loaded is still a valid element, only null ones and those loaded as garbage are skipped
+			const auto &SoftObject = *reinterpret_cast< const FSoftObjectPtr* >( ArrayHelper.GetRawPtr( idx ) );
+			if (SoftObject.IsNull( ))
+				continue;
+
+			const auto Object = SoftObject.GetUniqueID( ).ResolveObject( );
+			if ((Object == nullptr) || IsValid( Object ))
+				return idx;
+		}
+
+		return Num;
+	}
+
+	if (const auto ObjectProperty = CastField< FObjectPropertyBase >( ArrayProperty->Inner ))
+	{
+		for (int idx = FMath::Max( StartIndex, 0 ); idx < Num; ++idx)
+		{
+			if (IsValid( ObjectProperty->GetObjectPropertyValue( ArrayHelper.GetRawPtr( idx ) ) ))
+				return idx;
+		}
+
+		return Num;
+	}
+
+	if (CastField< FInterfaceProperty >( ArrayProperty->Inner ) != nullptr)
+	{
+		for (int idx = FMath::Max( StartIndex, 0 ); idx < Num; ++idx)
+		{
+			if (IsValid( reinterpret_cast< const FScriptInterface* >( ArrayHelper.GetRawPtr( idx ) )->GetObject( ) ))
+				return idx;
+		}
+
+		return Num;
+	}
+
+	// Not an array of objects, so there's nothing to skip
+	return FMath::Clamp( StartIndex, 0, Num );
+}
+
+bool UCoreTechArrayLibrary::FindPredicateParams( const UFunction *Predicate, FProperty *&ElementParam, FProperty *&ReturnParam, FObjectPropertyBase *&WorldContextParam )
+{
+	ElementParam = nullptr;
+	ReturnParam = nullptr;
+	WorldContextParam = nullptr;
+
+	if (Predicate == nullptr)
+		return false;
+
+	for (TFieldIterator< FProperty > It( Predicate ); It && It->HasAnyPropertyFlags( CPF_Parm ); ++It)
+	{
+		if (It->HasAnyPropertyFlags( CPF_ReturnParm ))
+			ReturnParam = *It;
+		else if ((WorldContextParam == nullptr) && (It->GetFName( ) == CoreTechArrayLibrary::BlueprintWorldContextName) && It->IsA< FObjectPropertyBase >( ))
+			WorldContextParam = CastField< FObjectPropertyBase >( *It );
+		else if (ElementParam == nullptr)
+			ElementParam = *It;
+		else
+			return false;
+	}
+
+	return (ElementParam != nullptr) && (ReturnParam != nullptr);
+}
+
+int32 UCoreTechArrayLibrary::GenericArray_FindFirstMatch( UObject *WorldContextObject, const void *TargetArray, const FArrayProperty *ArrayProperty, UObject *Target, FName PredicateName, void *Item )
+{
+	int32 Found = INDEX_NONE;
+	CoreTechArrayLibrary::ScanWithPredicate( WorldContextObject, TargetArray, ArrayProperty, Target, PredicateName, [ & ]( int32 Index, bool bMatch )
+	{
+		if (bMatch)
+			Found = Index;
+		return !bMatch;
+	} );
+
+	// The predicate could have changed the array since it matched, in which case the match is no good
+	FScriptArrayHelper ArrayHelper( ArrayProperty, TargetArray );
+	if ((Found != INDEX_NONE) && !ArrayHelper.IsValidIndex( Found ))
+		Found = INDEX_NONE;
+
+	if (Item != nullptr)
+	{
+		if (Found != INDEX_NONE)
+			ArrayProperty->Inner->CopySingleValueToScriptVM( Item, ArrayHelper.GetRawPtr( Found ) );
+		else
+			ArrayProperty->Inner->ClearValue( Item );
+	}
+
+	return Found;
+}
+
+bool UCoreTechArrayLibrary::GenericArray_AnyMatch( UObject *WorldContextObject, const void *TargetArray, const FArrayProperty *ArrayProperty, UObject *Target, FName PredicateName )
+{
+	bool bAny = false;
+	CoreTechArrayLibrary::ScanWithPredicate( WorldContextObject, TargetArray, ArrayProperty, Target, PredicateName, [ & ]( int32, bool bMatch )
+	{
+		bAny = bMatch;
+		return !bMatch;
+	} );
+
+	return bAny;
+}
+
+bool UCoreTechArrayLibrary::GenericArray_AllMatch( UObject *WorldContextObject, const void *TargetArray, const FArrayProperty *ArrayProperty, UObject *Target, FName PredicateName )
+{
+	bool bAll = true;
+	const bool bScanned = CoreTechArrayLibrary::ScanWithPredicate( WorldContextObject, TargetArray, ArrayProperty, Target, PredicateName, [ & ]( int32, bool bMatch )
+	{
+		bAll = bMatch;
+		return bMatch;
+	} );
+
+	// An empty array passes, but one that couldn't be tested doesn't
+	return bScanned && bAll;
+}
+
+int32 UCoreTechArrayLibrary::GenericArray_CountMatches( UObject *WorldContextObject, const void *TargetArray, const FArrayProperty *ArrayProperty, UObject *Target, FName PredicateName )
+{
+	int32 Count = 0;
+	CoreTechArrayLibrary::ScanWithPredicate( WorldContextObject, TargetArray, ArrayProperty, Target, PredicateName, [ & ]( int32, bool bMatch )
+	{
+		Count += bMatch ? 1 : 0;
+		return true;
+	} );
+
+	return Count;
+}
+
+int32 UCoreTechArrayLibrary::Array_SumInt( const TArray< int32 > &TargetArray ) { return CoreTechArrayLibrary::Sum( TargetArray ); }
+float UCoreTechArrayLibrary::Array_SumFloat( const TArray< float > &TargetArray ) { return CoreTechArrayLibrary::Sum( TargetArray ); }
+double UCoreTechArrayLibrary::Array_SumDouble( const TArray< double > &TargetArray ) { return CoreTechArrayLibrary::Sum( TargetArray ); }
+
+int32 UCoreTechArrayLibrary::Array_MinInt( const TArray< int32 > &TargetArray ) { return CoreTechArrayLibrary::Min( TargetArray ); }
+float UCoreTechArrayLibrary::Array_MinFloat( const TArray< float > &TargetArray ) { return CoreTechArrayLibrary::Min( TargetArray ); }
+double UCoreTechArrayLibrary::Array_MinDouble( const TArray< double > &TargetArray ) { return CoreTechArrayLibrary::Min( TargetArray ); }
+
+int32 UCoreTechArrayLibrary::Array_MaxInt( const TArray< int32 > &TargetArray ) { return CoreTechArrayLibrary::Max( TargetArray ); }
+float UCoreTechArrayLibrary::Array_MaxFloat( const TArray< float > &TargetArray ) { return CoreTechArrayLibrary::Max( TargetArray ); }
+double UCoreTechArrayLibrary::Array_MaxDouble( const TArray< double > &TargetArray ) { return CoreTechArrayLibrary::Max( TargetArray ); }
+
+double UCoreTechArrayLibrary::Array_AverageInt( const TArray< int32 > &TargetArray ) { return CoreTechArrayLibrary::Average( TargetArray ); }
+double UCoreTechArrayLibrary::Array_AverageFloat( const TArray< float > &TargetArray ) { return CoreTechArrayLibrary::Average( TargetArray ); }
+double UCoreTechArrayLibrary::Array_AverageDouble( const TArray< double > &TargetArray ) { return CoreTechArrayLibrary::Average( TargetArray ); }
+
+int32 UCoreTechArrayLibrary::Array_DotInt( const TArray< int32 > &A, const TArray< int32 > &B ) { return CoreTechArrayLibrary::Dot( A, B ); }
+float UCoreTechArrayLibrary::Array_DotFloat( const TArray< float > &A, const TArray< float > &B ) { return CoreTechArrayLibrary::Dot( A, B ); }
+double UCoreTechArrayLibrary::Array_DotDouble( const TArray< double > &A, const TArray< double > &B ) { return CoreTechArrayLibrary::Dot( A, B ); }
+
+void UCoreTechArrayLibrary::GenericArray_GetMember( const void *TargetArray, const FArrayProperty *ArrayProperty, int32 Index, FName MemberName, void *Value, const FProperty *ValueProperty )
+{
+	if ((TargetArray == nullptr) || (Value == nullptr))
+		return;
+
+	const auto Member = CoreTechArrayLibrary::FindMember( ArrayProperty->Inner, MemberName, ValueProperty );
+	if (Member == nullptr)
+	{
+		FFrame::KismetExecutionMessage( *FString::Printf( TEXT( "Attempted to get member '%s' that doesn't exist on the elements of array '%s'." ), *MemberName.ToString( ), *ArrayProperty->GetName( ) ), ELogVerbosity::Warning );
+		if (ValueProperty != nullptr)
+			ValueProperty->ClearValue( Value );
+		return;
+	}
+
+	FScriptArrayHelper ArrayHelper( ArrayProperty, TargetArray );
+	if (!ArrayHelper.IsValidIndex( Index ))
+	{
+		FFrame::KismetExecutionMessage( *FString::Printf( TEXT( "Attempted to get member '%s' of an item from array '%s' out of bounds [%d/%d]!" ), *MemberName.ToString( ), *ArrayProperty->GetName( ), Index, ArrayHelper.Num( ) ), ELogVerbosity::Warning );
+		ValueProperty->ClearValue( Value );
+		return;
+	}
+
+	// Read the member straight out of the array storage, as the whole value a pin holds (a bitfield bool is read out of its byte)
+	Member->CopySingleValueToScriptVM( Value, Member->ContainerPtrToValuePtr< void >( ArrayHelper.GetRawPtr( Index ) ) );
+}
+
+void UCoreTechArrayLibrary::GenericArray_GatherMember( const void *TargetArray, const FArrayProperty *ArrayProperty, FName MemberName, void *Result, const FArrayProperty *ResultProperty )
+{
+	if ((TargetArray == nullptr) || (Result == nullptr))
+		return;
+
+	FScriptArrayHelper ResultHelper( ResultProperty, Result );
+
+	const auto Member = CoreTechArrayLibrary::FindMember( ArrayProperty->Inner, MemberName, ResultProperty->Inner );
+	if (Member == nullptr)
+	{
+		FFrame::KismetExecutionMessage( *FString::Printf( TEXT( "Attempted to gather member '%s' that doesn't exist on the elements of array '%s'." ), *MemberName.ToString( ), *ArrayProperty->GetName( ) ), ELogVerbosity::Warning );
+		ResultHelper.EmptyValues( );
+		return;
+	}
+
+	FScriptArrayHelper ArrayHelper( ArrayProperty, TargetArray );
+	const auto Num = ArrayHelper.Num( );
+	if (Num == 0)
+	{
+		ResultHelper.EmptyValues( );
+		return;
+	}
+
+	// Walk the source with the stride of the whole struct, writing the members out back to back
+	const auto Stride = ArrayProperty->Inner->GetSize( );
+	const auto MemberSize = Member->GetSize( );
+	const auto Source = Member->ContainerPtrToValuePtr< uint8 >( ArrayHelper.GetRawPtr( 0 ) );
+
+	// Bitfield bools share their byte with other members, so they can't be copied as raw memory
+	if (Member->HasAnyPropertyFlags( CPF_IsPlainOldData ) && !Member->IsA< FBoolProperty >( ))
+	{
+		ResultHelper.EmptyAndAddUninitializedValues( Num );
+
+		auto Dest = ResultHelper.GetRawPtr( 0 );
+		for (int idx = 0; idx < Num; ++idx, Dest += MemberSize)
+			FMemory::Memcpy( Dest, Source + idx * Stride, MemberSize );
+	}
+	else if (const auto BoolMember = CastField< FBoolProperty >( Member ))
+	{
+		ResultHelper.EmptyAndAddValues( Num );
+
+		// Reads the bool out of its bitfield and writes it as the whole bool that an array of bools holds
+		for (int idx = 0; idx < Num; ++idx)
+			BoolMember->CopySingleValueToScriptVM( ResultHelper.GetRawPtr( idx ), Source + idx * Stride );
+	}
+	else
+	{
+		ResultHelper.EmptyAndAddValues( Num );
+
+		for (int idx = 0; idx < Num; ++idx)
+			Member->CopySingleValue( ResultHelper.GetRawPtr( idx ), Source + idx * Stride );
+	}
+}
+
+void UCoreTechArrayLibrary::GenericArray_ResetWithCapacity( void *TargetArray, const FArrayProperty *ArrayProperty, int32 Capacity )
+{
+	if (TargetArray == nullptr)
+		return;
+
+	FScriptArrayHelper ArrayHelper( ArrayProperty, TargetArray );
+	ArrayHelper.EmptyValues( FMath::Max( Capacity, 0 ) );
+}
+
+void UCoreTechArrayLibrary::GenericArray_RemoveIndices( void *TargetArray, const FArrayProperty *ArrayProperty, const TArray< int32 > &Indices, bool bKeepOrder )
+{
+	if ((TargetArray == nullptr) || (Indices.Num( ) == 0))
+		return;
+
+	FScriptArrayHelper ArrayHelper( ArrayProperty, TargetArray );
+	const auto Num = ArrayHelper.Num( );
+
+	// Swapping only moves the raw memory of the elements, so the removed elements are gathered at the end
+	// and destroyed together without any of the remaining elements being copied
+	if (bKeepOrder)
+	{
+		// Every kept element moves down past the removed elements before it, at most once
+		int32 Write = 0;
+		int32 NextRemoved = 0;
+		for (int Read = 0; Read < Num; ++Read)
+		{
+			while ((NextRemoved < Indices.Num( )) && (Indices[ NextRemoved ] < Read))
+				++NextRemoved;
+
+			if ((NextRemoved < Indices.Num( )) && (Indices[ NextRemoved ] == Read))
+				continue;
+
+			if (Write != Read)
+				ArrayHelper.SwapValues( Write, Read );
+
+			++Write;
+		}
+
+		if (Write < Num)
+			ArrayHelper.RemoveValues( Write, Num - Write );
+	}
+	else
+	{
+		// Working down from the highest index, each gap is filled from the end and only removed elements are behind the tail
+		int32 Tail = Num;
+		int32 Previous = Num;
+		for (int idx = Indices.Num( ) - 1; idx >= 0; --idx)
+		{
+			const auto Index = Indices[ idx ];
+			if ((Index < 0) || (Index >= Previous))
+				continue;
+
+			Previous = Index;
+			--Tail;
+
+			if (Index != Tail)
+				ArrayHelper.SwapValues( Index, Tail );
+		}
+
+		if (Tail < Num)
+			ArrayHelper.RemoveValues( Tail, Num - Tail );
+	}
+}
+
+bool UCoreTechArrayLibrary::GenericMap_NextSlot( const void *TargetMap, const FMapProperty *MapProperty, int32 &Slot )
+{
+	if (TargetMap == nullptr)
+		return false;
+
+	// Walk the sparse storage directly instead of taking a copy of the keys, skipping over the holes left by removals
+	FScriptMapHelper MapHelper( MapProperty, TargetMap );
+	const auto MaxIndex = MapHelper.GetMaxIndex( );
+
+	// A slot that has been broken out of the loop is past the end and stays there
+	for (Slot = (Slot < MaxIndex) ? FMath::Max( Slot + 1, 0 ) : MaxIndex; Slot < MaxIndex; ++Slot)
+	{
+		if (MapHelper.IsValidIndex( Slot ))
+			return true;
+	}
+
+	return false;
+}
+
+void UCoreTechArrayLibrary::GenericMap_GetSlot( const void *TargetMap, const FMapProperty *MapProperty, int32 Slot, void *Key, void *Value )
+{
+	if (TargetMap == nullptr)
+		return;
+
+	FScriptMapHelper MapHelper( MapProperty, TargetMap );
+	if (!MapHelper.IsValidIndex( Slot ))
+	{
+		FFrame::KismetExecutionMessage( *FString::Printf( TEXT( "Attempted to get an element from an empty slot [%d] of map '%s'!" ), Slot, *MapProperty->GetName( ) ), ELogVerbosity::Warning );
+
+		if (Key != nullptr)
+			MapProperty->KeyProp->ClearValue( Key );
+		if (Value != nullptr)
+			MapProperty->ValueProp->ClearValue( Value );
+		return;
+	}
+
+	if (Key != nullptr)
+		MapProperty->KeyProp->CopyCompleteValueToScriptVM( Key, MapHelper.GetKeyPtr( Slot ) );
+	if (Value != nullptr)
+		MapProperty->ValueProp->CopyCompleteValueToScriptVM( Value, MapHelper.GetValuePtr( Slot ) );
+}
+
+void UCoreTechArrayLibrary::GenericMap_GetSlotMember( const void *TargetMap, const FMapProperty *MapProperty, int32 Slot, FName MemberName, void *Value, const FProperty *ValueProperty )
+{
+	if ((TargetMap == nullptr) || (Value == nullptr))
+		return;
+
+	const auto Member = CoreTechArrayLibrary::FindMember( MapProperty->ValueProp, MemberName, ValueProperty );
+	if (Member == nullptr)
+	{
+		FFrame::KismetExecutionMessage( *FString::Printf( TEXT( "Attempted to get member '%s' that doesn't exist on the values of map '%s'." ), *MemberName.ToString( ), *MapProperty->GetName( ) ), ELogVerbosity::Warning );
+		if (ValueProperty != nullptr)
+			ValueProperty->ClearValue( Value );
+		return;
+	}
+
+	FScriptMapHelper MapHelper( MapProperty, TargetMap );
+	if (!MapHelper.IsValidIndex( Slot ))
+	{
+		FFrame::KismetExecutionMessage( *FString::Printf( TEXT( "Attempted to get member '%s' from an empty slot [%d] of map '%s'!" ), *MemberName.ToString( ), Slot, *MapProperty->GetName( ) ), ELogVerbosity::Warning );
+		ValueProperty->ClearValue( Value );
+		return;
+	}
+
+	// Read the member straight out of the map storage, as the whole value a pin holds (a bitfield bool is read out of its byte)
+	Member->CopySingleValueToScriptVM( Value, Member->ContainerPtrToValuePtr< void >( MapHelper.GetValuePtr( Slot ) ) );
+}
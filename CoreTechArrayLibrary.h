@@ -0,0 +1,446 @@
+
+#pragma once
+
+#include "Kismet/BlueprintFunctionLibrary.h"
+
+#include "CoreTechArrayLibrary.generated.h"
+
+// Native support functions for the custom container K2 nodes
+UCLASS( )
+class CORETECH_API UCoreTechArrayLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY( )
+public:
+	// Copy a single member out of a struct array element without copying the rest of the element
+	UFUNCTION( BlueprintPure, CustomThunk, meta = (BlueprintInternalUseOnly = "true", ArrayParm = "TargetArray", CustomStructureParam = "Value") )
+	static void Array_GetMember( const TArray< int32 > &TargetArray, int32 Index, FName MemberName, int32 &Value );
+
+	// Step the slot to the next element in the storage of the map, returning false once there are no elements left
+	UFUNCTION( BlueprintCallable, CustomThunk, meta = (BlueprintInternalUseOnly = "true", MapParam = "TargetMap") )
+	static bool Map_NextSlot( const TMap< int32, int32 > &TargetMap, UPARAM( ref ) int32 &Slot );
+
+	// Copy the key of the element in a slot of the map storage
+	UFUNCTION( BlueprintPure, CustomThunk, meta = (BlueprintInternalUseOnly = "true", MapParam = "TargetMap", MapKeyParam = "Key") )
+	static void Map_GetSlotKey( const TMap< int32, int32 > &TargetMap, int32 Slot, int32 &Key );
+
+	// Copy the value of the element in a slot of the map storage
+	UFUNCTION( BlueprintPure, CustomThunk, meta = (BlueprintInternalUseOnly = "true", MapParam = "TargetMap", MapValueParam = "Value") )
+	static void Map_GetSlotValue( const TMap< int32, int32 > &TargetMap, int32 Slot, int32 &Value );
+
+	// Copy a single member out of the struct value in a slot of the map storage without copying the rest of the value
+	UFUNCTION( BlueprintPure, CustomThunk, meta = (BlueprintInternalUseOnly = "true", MapParam = "TargetMap", CustomStructureParam = "Value") )
+	static void Map_GetSlotMember( const TMap< int32, int32 > &TargetMap, int32 Slot, FName MemberName, int32 &Value );
+
+	// Copy a single member out of every struct array element into a contiguous array, sized up front and filled in one pass
+	UFUNCTION( BlueprintPure, CustomThunk, meta = (BlueprintInternalUseOnly = "true", ArrayParm = "TargetArray,Result") )
+	static void Array_GatherMember( const TArray< int32 > &TargetArray, FName MemberName, TArray< int32 > &Result );
+
+	// Empty an array and make room for Capacity elements, so that adding up to that many doesn't reallocate
+	UFUNCTION( BlueprintCallable, CustomThunk, meta = (BlueprintInternalUseOnly = "true", ArrayParm = "TargetArray") )
+	static void Array_ResetWithCapacity( UPARAM( ref ) TArray< int32 > &TargetArray, int32 Capacity );
+
+	// Remove the elements at the (ascending) indices in one pass, either keeping the order of the remaining elements or filling the gaps from the end
+	UFUNCTION( BlueprintCallable, CustomThunk, meta = (BlueprintInternalUseOnly = "true", ArrayParm = "TargetArray") )
+	static void Array_RemoveIndices( UPARAM( ref ) TArray< int32 > &TargetArray, const TArray< int32 > &Indices, bool bKeepOrder );
+
+	// Find the first index at or after StartIndex that holds a live object, or the length of the array if there isn't one
+	UFUNCTION( BlueprintPure, CustomThunk, meta = (BlueprintInternalUseOnly = "true", ArrayParm = "TargetArray") )
+	static int32 Array_NextValidIndex( const TArray< int32 > &TargetArray, int32 StartIndex );
+
+	// Find the first element that the predicate function of Target returns true for, returning false if there isn't one
+	UFUNCTION( BlueprintPure, CustomThunk, meta = (BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject", ArrayParm = "TargetArray", ArrayTypeDependentParams = "Item") )
+	static bool Array_FindFirstMatch( const UObject *WorldContextObject, const TArray< int32 > &TargetArray, UObject *Target, FName PredicateName, int32 &Item, int32 &Index );
+
+	// Whether the predicate function of Target returns true for any element, stopping at the first one that does
+	UFUNCTION( BlueprintPure, CustomThunk, meta = (BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject", ArrayParm = "TargetArray") )
+	static bool Array_AnyMatch( const UObject *WorldContextObject, const TArray< int32 > &TargetArray, UObject *Target, FName PredicateName );
+
+	// Whether the predicate function of Target returns true for every element, stopping at the first one that doesn't
+	UFUNCTION( BlueprintPure, CustomThunk, meta = (BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject", ArrayParm = "TargetArray") )
+	static bool Array_AllMatch( const UObject *WorldContextObject, const TArray< int32 > &TargetArray, UObject *Target, FName PredicateName );
+
+	// Count the elements that the predicate function of Target returns true for
+	UFUNCTION( BlueprintPure, CustomThunk, meta = (BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject", ArrayParm = "TargetArray") )
+	static int32 Array_CountMatches( const UObject *WorldContextObject, const TArray< int32 > &TargetArray, UObject *Target, FName PredicateName );
+
+	// Add together all the elements of an array. Integer sums wrap around on overflow.
+	UFUNCTION( BlueprintPure, meta = (BlueprintInternalUseOnly = "true") )
+	static int32 Array_SumInt( const TArray< int32 > &TargetArray );
+	UFUNCTION( BlueprintPure, meta = (BlueprintInternalUseOnly = "true") )
+	static float Array_SumFloat( const TArray< float > &TargetArray );
+	UFUNCTION( BlueprintPure, meta = (BlueprintInternalUseOnly = "true") )
+	static double Array_SumDouble( const TArray< double > &TargetArray );
+
+	// Find the smallest element of an array (zero if the array is empty)
+	UFUNCTION( BlueprintPure, meta = (BlueprintInternalUseOnly = "true") )
+	static int32 Array_MinInt( const TArray< int32 > &TargetArray );
+	UFUNCTION( BlueprintPure, meta = (BlueprintInternalUseOnly = "true") )
+	static float Array_MinFloat( const TArray< float > &TargetArray );
+	UFUNCTION( BlueprintPure, meta = (BlueprintInternalUseOnly = "true") )
+	static double Array_MinDouble( const TArray< double > &TargetArray );
+
+	// Find the largest element of an array (zero if the array is empty)
+	UFUNCTION( BlueprintPure, meta = (BlueprintInternalUseOnly = "true") )
+	static int32 Array_MaxInt( const TArray< int32 > &TargetArray );
+	UFUNCTION( BlueprintPure, meta = (BlueprintInternalUseOnly = "true") )
+	static float Array_MaxFloat( const TArray< float > &TargetArray );
+	UFUNCTION( BlueprintPure, meta = (BlueprintInternalUseOnly = "true") )
+	static double Array_MaxDouble( const TArray< double > &TargetArray );
+
+	// Find the mean of all the elements of an array (zero if the array is empty)
+	UFUNCTION( BlueprintPure, meta = (BlueprintInternalUseOnly = "true") )
+	static double Array_AverageInt( const TArray< int32 > &TargetArray );
+	UFUNCTION( BlueprintPure, meta = (BlueprintInternalUseOnly = "true") )
+	static double Array_AverageFloat( const TArray< float > &TargetArray );
+	UFUNCTION( BlueprintPure, meta = (BlueprintInternalUseOnly = "true") )
+	static double Array_AverageDouble( const TArray< double > &TargetArray );
+
+	// Sum the products of the matching elements of two arrays (only up to the length of the shorter array). Integer sums wrap around on overflow.
+	UFUNCTION( BlueprintPure, meta = (BlueprintInternalUseOnly = "true") )
+	static int32 Array_DotInt( const TArray< int32 > &A, const TArray< int32 > &B );
+	UFUNCTION( BlueprintPure, meta = (BlueprintInternalUseOnly = "true") )
+	static float Array_DotFloat( const TArray< float > &A, const TArray< float > &B );
+	UFUNCTION( BlueprintPure, meta = (BlueprintInternalUseOnly = "true") )
+	static double Array_DotDouble( const TArray< double > &A, const TArray< double > &B );
+
+	// Find the element and return parameters of a predicate function, allowing for the hidden world context parameter that the functions of
+	// Blueprint function libraries have. Returns false if the predicate has any other parameters.
+	static bool FindPredicateParams( const UFunction *Predicate, FProperty *&ElementParam, FProperty *&ReturnParam, FObjectPropertyBase *&WorldContextParam );
+
+	// Native implementations of the custom thunks
+	static void GenericArray_GetMember( const void *TargetArray, const FArrayProperty *ArrayProperty, int32 Index, FName MemberName, void *Value, const FProperty *ValueProperty );
+	static void GenericArray_GatherMember( const void *TargetArray, const FArrayProperty *ArrayProperty, FName MemberName, void *Result, const FArrayProperty *ResultProperty );
+	static void GenericArray_ResetWithCapacity( void *TargetArray, const FArrayProperty *ArrayProperty, int32 Capacity );
+	static void GenericArray_RemoveIndices( void *TargetArray, const FArrayProperty *ArrayProperty, const TArray< int32 > &Indices, bool bKeepOrder );
+	static bool GenericMap_NextSlot( const void *TargetMap, const FMapProperty *MapProperty, int32 &Slot );
+	static void GenericMap_GetSlot( const void *TargetMap, const FMapProperty *MapProperty, int32 Slot, void *Key, void *Value );
+	static void GenericMap_GetSlotMember( const void *TargetMap, const FMapProperty *MapProperty, int32 Slot, FName MemberName, void *Value, const FProperty *ValueProperty );
+	static int32 GenericArray_NextValidIndex( const void *TargetArray, const FArrayProperty *ArrayProperty, int32 StartIndex );
+	static int32 GenericArray_FindFirstMatch( UObject *WorldContextObject, const void *TargetArray, const FArrayProperty *ArrayProperty, UObject *Target, FName PredicateName, void *Item );
+	static bool GenericArray_AnyMatch( UObject *WorldContextObject, const void *TargetArray, const FArrayProperty *ArrayProperty, UObject *Target, FName PredicateName );
+	static bool GenericArray_AllMatch( UObject *WorldContextObject, const void *TargetArray, const FArrayProperty *ArrayProperty, UObject *Target, FName PredicateName );
+	static int32 GenericArray_CountMatches( UObject *WorldContextObject, const void *TargetArray, const FArrayProperty *ArrayProperty, UObject *Target, FName PredicateName );
+
+	DECLARE_FUNCTION( execArray_GetMember )
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn< FArrayProperty >( nullptr );
+		const void *ArrayAddr = Stack.MostRecentPropertyAddress;
+		const auto ArrayProperty = CastField< FArrayProperty >( Stack.MostRecentProperty );
+		if (ArrayProperty == nullptr)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_PROPERTY( FIntProperty, Index );
+		P_GET_PROPERTY( FNameProperty, MemberName );
+
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn< FProperty >( nullptr );
+		void *ValueAddr = Stack.MostRecentPropertyAddress;
+		const auto ValueProperty = Stack.MostRecentProperty;
+
+		P_FINISH;
+
+		P_NATIVE_BEGIN;
+		GenericArray_GetMember( ArrayAddr, ArrayProperty, Index, MemberName, ValueAddr, ValueProperty );
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION( execArray_GatherMember )
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn< FArrayProperty >( nullptr );
+		const void *ArrayAddr = Stack.MostRecentPropertyAddress;
+		const auto ArrayProperty = CastField< FArrayProperty >( Stack.MostRecentProperty );
+		if (ArrayProperty == nullptr)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_PROPERTY( FNameProperty, MemberName );
+
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn< FArrayProperty >( nullptr );
+		void *ResultAddr = Stack.MostRecentPropertyAddress;
+		const auto ResultProperty = CastField< FArrayProperty >( Stack.MostRecentProperty );
+		if (ResultProperty == nullptr)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_FINISH;
+
+		P_NATIVE_BEGIN;
+		GenericArray_GatherMember( ArrayAddr, ArrayProperty, MemberName, ResultAddr, ResultProperty );
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION( execArray_ResetWithCapacity )
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn< FArrayProperty >( nullptr );
+		void *ArrayAddr = Stack.MostRecentPropertyAddress;
+		const auto ArrayProperty = CastField< FArrayProperty >( Stack.MostRecentProperty );
+		if (ArrayProperty == nullptr)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_PROPERTY( FIntProperty, Capacity );
+
+		P_FINISH;
+
+		P_NATIVE_BEGIN;
+		GenericArray_ResetWithCapacity( ArrayAddr, ArrayProperty, Capacity );
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION( execArray_RemoveIndices )
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn< FArrayProperty >( nullptr );
+		void *ArrayAddr = Stack.MostRecentPropertyAddress;
+		const auto ArrayProperty = CastField< FArrayProperty >( Stack.MostRecentProperty );
+		if (ArrayProperty == nullptr)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_TARRAY_REF( int32, Indices );
+		P_GET_UBOOL( bKeepOrder );
+
+		P_FINISH;
+
+		P_NATIVE_BEGIN;
+		GenericArray_RemoveIndices( ArrayAddr, ArrayProperty, Indices, bKeepOrder );
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION( execMap_NextSlot )
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn< FMapProperty >( nullptr );
+		const void *MapAddr = Stack.MostRecentPropertyAddress;
+		const auto MapProperty = CastField< FMapProperty >( Stack.MostRecentProperty );
+		if (MapProperty == nullptr)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_PROPERTY_REF( FIntProperty, Slot );
+
+		P_FINISH;
+
+		P_NATIVE_BEGIN;
+		*(bool*)RESULT_PARAM = GenericMap_NextSlot( MapAddr, MapProperty, Slot );
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION( execMap_GetSlotKey )
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn< FMapProperty >( nullptr );
+		const void *MapAddr = Stack.MostRecentPropertyAddress;
+		const auto MapProperty = CastField< FMapProperty >( Stack.MostRecentProperty );
+		if (MapProperty == nullptr)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_PROPERTY( FIntProperty, Slot );
+
+		Stack.MostRecentPropertyAddress = nullptr;
+		Stack.StepCompiledIn< FProperty >( nullptr );
+		void *KeyAddr = Stack.MostRecentPropertyAddress;
+
+		P_FINISH;
+
+		P_NATIVE_BEGIN;
+		GenericMap_GetSlot( MapAddr, MapProperty, Slot, KeyAddr, nullptr );
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION( execMap_GetSlotValue )
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn< FMapProperty >( nullptr );
+		const void *MapAddr = Stack.MostRecentPropertyAddress;
+		const auto MapProperty = CastField< FMapProperty >( Stack.MostRecentProperty );
+		if (MapProperty == nullptr)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_PROPERTY( FIntProperty, Slot );
+
+		Stack.MostRecentPropertyAddress = nullptr;
+		Stack.StepCompiledIn< FProperty >( nullptr );
+		void *ValueAddr = Stack.MostRecentPropertyAddress;
+
+		P_FINISH;
+
+		P_NATIVE_BEGIN;
+		GenericMap_GetSlot( MapAddr, MapProperty, Slot, nullptr, ValueAddr );
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION( execMap_GetSlotMember )
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn< FMapProperty >( nullptr );
+		const void *MapAddr = Stack.MostRecentPropertyAddress;
+		const auto MapProperty = CastField< FMapProperty >( Stack.MostRecentProperty );
+		if (MapProperty == nullptr)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_PROPERTY( FIntProperty, Slot );
+		P_GET_PROPERTY( FNameProperty, MemberName );
+
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn< FProperty >( nullptr );
+		void *ValueAddr = Stack.MostRecentPropertyAddress;
+		const auto ValueProperty = Stack.MostRecentProperty;
+
+		P_FINISH;
+
+		P_NATIVE_BEGIN;
+		GenericMap_GetSlotMember( MapAddr, MapProperty, Slot, MemberName, ValueAddr, ValueProperty );
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION( execArray_NextValidIndex )
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn< FArrayProperty >( nullptr );
+		const void *ArrayAddr = Stack.MostRecentPropertyAddress;
+		const auto ArrayProperty = CastField< FArrayProperty >( Stack.MostRecentProperty );
+		if (ArrayProperty == nullptr)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_PROPERTY( FIntProperty, StartIndex );
+
+		P_FINISH;
+
+		P_NATIVE_BEGIN;
+		*(int32*)RESULT_PARAM = GenericArray_NextValidIndex( ArrayAddr, ArrayProperty, StartIndex );
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION( execArray_FindFirstMatch )
+	{
+		P_GET_OBJECT( UObject, WorldContextObject );
+
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn< FArrayProperty >( nullptr );
+		const void *ArrayAddr = Stack.MostRecentPropertyAddress;
+		const auto ArrayProperty = CastField< FArrayProperty >( Stack.MostRecentProperty );
+		if (ArrayProperty == nullptr)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_OBJECT( UObject, Target );
+		P_GET_PROPERTY( FNameProperty, PredicateName );
+
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn< FProperty >( nullptr );
+		void *ItemAddr = Stack.MostRecentPropertyAddress;
+
+		P_GET_PROPERTY_REF( FIntProperty, Index );
+
+		P_FINISH;
+
+		P_NATIVE_BEGIN;
+		Index = GenericArray_FindFirstMatch( WorldContextObject, ArrayAddr, ArrayProperty, Target, PredicateName, ItemAddr );
+		*(bool*)RESULT_PARAM = (Index != INDEX_NONE);
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION( execArray_AnyMatch )
+	{
+		P_GET_OBJECT( UObject, WorldContextObject );
+
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn< FArrayProperty >( nullptr );
+		const void *ArrayAddr = Stack.MostRecentPropertyAddress;
+		const auto ArrayProperty = CastField< FArrayProperty >( Stack.MostRecentProperty );
+		if (ArrayProperty == nullptr)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_OBJECT( UObject, Target );
+		P_GET_PROPERTY( FNameProperty, PredicateName );
+
+		P_FINISH;
+
+		P_NATIVE_BEGIN;
+		*(bool*)RESULT_PARAM = GenericArray_AnyMatch( WorldContextObject, ArrayAddr, ArrayProperty, Target, PredicateName );
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION( execArray_AllMatch )
+	{
+		P_GET_OBJECT( UObject, WorldContextObject );
+
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn< FArrayProperty >( nullptr );
+		const void *ArrayAddr = Stack.MostRecentPropertyAddress;
+		const auto ArrayProperty = CastField< FArrayProperty >( Stack.MostRecentProperty );
+		if (ArrayProperty == nullptr)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_OBJECT( UObject, Target );
+		P_GET_PROPERTY( FNameProperty, PredicateName );
+
+		P_FINISH;
+
+		P_NATIVE_BEGIN;
+		*(bool*)RESULT_PARAM = GenericArray_AllMatch( WorldContextObject, ArrayAddr, ArrayProperty, Target, PredicateName );
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION( execArray_CountMatches )
+	{
+		P_GET_OBJECT( UObject, WorldContextObject );
+
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn< FArrayProperty >( nullptr );
+		const void *ArrayAddr = Stack.MostRecentPropertyAddress;
+		const auto ArrayProperty = CastField< FArrayProperty >( Stack.MostRecentProperty );
+		if (ArrayProperty == nullptr)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_OBJECT( UObject, Target );
+		P_GET_PROPERTY( FNameProperty, PredicateName );
+
+		P_FINISH;
+
+		P_NATIVE_BEGIN;
+		*(int32*)RESULT_PARAM = GenericArray_CountMatches( WorldContextObject, ArrayAddr, ArrayProperty, Target, PredicateName );
+		P_NATIVE_END;
+	}
+};
\ No newline at end of file
@@ -0,0 +1,48 @@
+
+#pragma once
+
+#include "UObject/Interface.h"
+
+#include "CoreTechIterable.generated.h"
+
+// Opaque state used by the For Each (Iterable) node to walk a native container one element at a time
+USTRUCT( BlueprintType, meta = (BlueprintInternalUseOnly = "true") )
+struct CORETECH_API FCoreTechIterableCursor
+{
+	GENERATED_BODY( )
+
+	// The container being walked, cleared once there are no more elements
+	TWeakObjectPtr< UObject > Container;
+
+	// The type that the elements are read as, checked against the container when the cursor is prepared
+	const FProperty *ElementProperty = nullptr;
+
+	// Positions within the container, for the container to use however suits its storage (slot, cell and entry, etc)
+	int32 Index = INDEX_NONE;
+	int32 SubIndex = INDEX_NONE;
+};
+
+UINTERFACE( meta = (CannotImplementInterfaceInBlueprint) )
+class CORETECH_API UCoreTechIterable : public UInterface
+{
+	GENERATED_BODY( )
+};
+
+// Native containers that the For Each (Iterable) node can walk directly, without copying their contents into an array first
+class CORETECH_API ICoreTechIterable
+{
+	GENERATED_BODY( )
+public:
+	// Describe the elements of the container. This is asked of the class default object to type the element pin in the editor,
+	// so it must be the same for every instance (usually the inner property of the array that the container stores its elements in).
+	UE_NODISCARD virtual const FProperty* GetIterableElementProperty( ) const = 0;
+
+	// Position the cursor at the first element, or past the end if there aren't any
+	virtual void IterableBegin( FCoreTechIterableCursor &Cursor ) const = 0;
+
+	// Move the cursor on from the element it's at to the next one, or past the end if there aren't any more
+	virtual void IterableAdvance( FCoreTechIterableCursor &Cursor ) const = 0;
+
+	// The element at the cursor, laid out as described by the element property, or null once the cursor is past the end
+	UE_NODISCARD virtual const void* IterableCurrent( const FCoreTechIterableCursor &Cursor ) const = 0;
+};
\ No newline at end of file
@@ -0,0 +1,331 @@
+#include "CoreTechIterationLibrary.h"
+
+// Engine
+#include "Engine/AssetManager.h"
+#include "Engine/DataTable.h"
+#include "Engine/Engine.h"
+#include "Engine/Level.h"
+#include "Engine/StreamableManager.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "LatentActions.h"
+
+void UCoreTechIterationLibrary::ActorCursor_Begin( const UObject *WorldContextObject, FCoreTechActorCursor &Cursor )
+{
+	Cursor.World = GEngine->GetWorldFromContextObject( WorldContextObject, EGetWorldErrorMode::LogAndReturnNull );
+	Cursor.LevelIndex = 0;
+	Cursor.ActorIndex = 0;
+}
+
+bool UCoreTechIterationLibrary::ActorCursor_Next( FCoreTechActorCursor &Cursor, TSubclassOf< AActor > ActorClass, AActor *&Actor )
+{
+	Actor = nullptr;
+
+	const auto World = Cursor.World.Get( );
+	if ((World == nullptr) || (ActorClass == nullptr))
+		return false;
+
+	// Walk the level actor lists in place instead of gathering the matches up front. Everything is re-checked
+	// against the current list sizes each step since the loop body is free to spawn or destroy actors.
+	const auto &Levels = World->GetLevels( );
+	for (; Cursor.LevelIndex < Levels.Num( ); ++Cursor.LevelIndex, Cursor.ActorIndex = 0)
+	{
+		const auto Level = Levels[ Cursor.LevelIndex ];
+
+		// Same as TActorIterator, only visit the actors of levels that are part of the world right now
+		if ((Level == nullptr) || (!Level->bIsVisible && (Level != World->PersistentLevel)))
+			continue;
+
+		while (Cursor.ActorIndex < Level->Actors.Num( ))
+		{
+			const auto Candidate = Level->Actors[ Cursor.ActorIndex++ ];
+			if (IsValid( Candidate ) && Candidate->IsA( ActorClass ))
+			{
+				Actor = Candidate;
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+void UCoreTechIterationLibrary::ActorCursor_End( FCoreTechActorCursor &Cursor )
+{
+	Cursor.World = nullptr;
+}
+
+// Latent action that finishes once a chunk request is no longer loading
+class FCoreTechWaitForChunkAction : public FPendingLatentAction
+{
+public:
+	FCoreTechWaitForChunkAction( const TSharedPtr< FStreamableHandle > &InHandle, const FLatentActionInfo &LatentInfo ) :
+		Handle( InHandle ), ExecutionFunction( LatentInfo.ExecutionFunction ), OutputLink( LatentInfo.Linkage ), CallbackTarget( LatentInfo.CallbackTarget )
+	{
+	}
+
+	void UpdateOperation( FLatentResponse &Response ) override
+	{
+		Response.FinishAndTriggerIf( !Handle.IsValid( ) || !Handle->IsLoadingInProgress( ), ExecutionFunction, OutputLink, CallbackTarget );
+	}
+
+private:
+	TSharedPtr< FStreamableHandle > Handle;
+
+	FName ExecutionFunction;
+	int32 OutputLink;
+	FWeakObjectPtr CallbackTarget;
+};
+
+void UCoreTechIterationLibrary::SoftObjectCursor_Begin( FCoreTechSoftObjectCursor &Cursor )
+{
+	SoftObjectCursor_End( Cursor );
+
+	Cursor.ChunkEnd = 0;
+	Cursor.NextChunkEnd = 0;
+	Cursor.Index = INDEX_NONE;
+}
+
+// Request a range of the array as a single batch, including anything already loaded so that the handle keeps it around
+static TSharedPtr< FStreamableHandle > RequestSoftObjects( const TArray< TSoftObjectPtr< UObject > > &SoftObjects, int32 Start, int32 End )
+{
+	TArray< FSoftObjectPath > Paths;
+	Paths.Reserve( End - Start );
+	for (int32 Idx = Start; Idx < End; ++Idx)
+	{
+		if (!SoftObjects[ Idx ].IsNull( ))
+			Paths.Add( SoftObjects[ Idx ].ToSoftObjectPath( ) );
+	}
+
+	if (Paths.Num( ) == 0)
+		return nullptr;
+
+	return UAssetManager::GetStreamableManager( ).RequestAsyncLoad( MoveTemp( Paths ) );
+}
+
+// Let go of a request, cancelling it if it's still loading
+static void ReleaseSoftObjects( TSharedPtr< FStreamableHandle > &Handle )
+{
+	if (!Handle.IsValid( ))
+		return;
+
+	if (Handle->IsLoadingInProgress( ))
+		Handle->CancelHandle( );
+	else
+		Handle->ReleaseHandle( );
+
+	Handle.Reset( );
+}
+
+bool UCoreTechIterationLibrary::SoftObjectCursor_RequestChunk( const TArray< TSoftObjectPtr< UObject > > &SoftObjects, int32 ChunkSize, FCoreTechSoftObjectCursor &Cursor, bool &bLoaded )
+{
+	bLoaded = true;
+
+	// Only let go of the previous chunk after the next one has been requested so that anything shared between them stays put
+	auto PreviousHandle = MoveTemp( Cursor.Handle );
+
+	const auto ChunkStart = Cursor.ChunkEnd;
+	if (ChunkStart < SoftObjects.Num( ))
+	{
+		const auto GetChunkEnd = [ &SoftObjects, ChunkSize ]( int32 Start )
+		{
+			const auto Remaining = SoftObjects.Num( ) - Start;
+			return Start + (((ChunkSize > 0) && (ChunkSize < Remaining)) ? ChunkSize : Remaining);
+		};
+
+		// Pick up the chunk that was requested ahead of time, unless the array has changed underneath it
+		if ((Cursor.NextChunkEnd > ChunkStart) && (Cursor.NextChunkEnd <= SoftObjects.Num( )))
+		{
+			Cursor.Handle = MoveTemp( Cursor.NextHandle );
+			Cursor.ChunkEnd = Cursor.NextChunkEnd;
+		}
+		else
+		{
+			ReleaseSoftObjects( Cursor.NextHandle );
+
+			Cursor.ChunkEnd = GetChunkEnd( ChunkStart );
+			Cursor.Handle = RequestSoftObjects( SoftObjects, ChunkStart, Cursor.ChunkEnd );
+		}
+
+		Cursor.Index = ChunkStart - 1;
+		bLoaded = !Cursor.Handle.IsValid( ) || !Cursor.Handle->IsLoadingInProgress( );
+
+		// Start loading the chunk after this one so that it can load while this one is visited
+		Cursor.NextChunkEnd = (Cursor.ChunkEnd < SoftObjects.Num( )) ? GetChunkEnd( Cursor.ChunkEnd ) : 0;
+		if (Cursor.NextChunkEnd > 0)
+			Cursor.NextHandle = RequestSoftObjects( SoftObjects, Cursor.ChunkEnd, Cursor.NextChunkEnd );
+	}
+
+	if (PreviousHandle.IsValid( ))
+		PreviousHandle->ReleaseHandle( );
+
+	return ChunkStart < SoftObjects.Num( );
+}
+
+void UCoreTechIterationLibrary::SoftObjectCursor_WaitForChunk( const UObject *WorldContextObject, const FCoreTechSoftObjectCursor &Cursor, FLatentActionInfo LatentInfo )
+{
+	const auto World = GEngine->GetWorldFromContextObject( WorldContextObject, EGetWorldErrorMode::LogAndReturnNull );
+	if (World == nullptr)
+		return;
+
+	auto &LatentManager = World->GetLatentActionManager( );
+	if (LatentManager.FindExistingAction< FCoreTechWaitForChunkAction >( LatentInfo.CallbackTarget, LatentInfo.UUID ) == nullptr)
+		LatentManager.AddNewAction( LatentInfo.CallbackTarget, LatentInfo.UUID, new FCoreTechWaitForChunkAction( Cursor.Handle, LatentInfo ) );
+}
+
+bool UCoreTechIterationLibrary::SoftObjectCursor_Next( FCoreTechSoftObjectCursor &Cursor, int32 &Index )
+{
+	// Written to not overflow once the cursor has been exhausted
+	if (Cursor.Index >= Cursor.ChunkEnd - 1)
+	{
+		Index = INDEX_NONE;
+		return false;
+	}
+
+	Index = ++Cursor.Index;
+	return true;
+}
+
+void UCoreTechIterationLibrary::SoftObjectCursor_End( FCoreTechSoftObjectCursor &Cursor )
+{
+	ReleaseSoftObjects( Cursor.Handle );
+	ReleaseSoftObjects( Cursor.NextHandle );
+
+	Cursor.ChunkEnd = MAX_int32;
+	Cursor.NextChunkEnd = 0;
+	Cursor.Index = MAX_int32;
+}
+
+UObject* UCoreTechIterationLibrary::SoftObjectCursor_Get( const TArray< TSoftObjectPtr< UObject > > &SoftObjects, int32 Index )
+{
+	return SoftObjects.IsValidIndex( Index ) ? SoftObjects[ Index ].Get( ) : nullptr;
+}
+
+void UCoreTechIterationLibrary::Generic_IterableCursor_Begin( UObject *Container, FCoreTechIterableCursor &Cursor, const FProperty *ElementProperty )
+{
+	Cursor = FCoreTechIterableCursor( );
+
+	const auto Iterable = Cast< ICoreTechIterable >( Container );
+	if ((Iterable == nullptr) || (ElementProperty == nullptr))
+		return;
+
+	// The element pin was typed from the class default object, make sure this container agrees before reading its memory that way
+	const auto DeclaredProperty = Iterable->GetIterableElementProperty( );
+	if ((DeclaredProperty == nullptr) || !DeclaredProperty->SameType( ElementProperty ))
+	{
+		FFrame::KismetExecutionMessage( *FString::Printf( TEXT( "Elements of iterable '%s' can't be read as '%s'." ), *Container->GetPathName( ), *ElementProperty->GetCPPType( ) ), ELogVerbosity::Warning );
+		return;
+	}
+
+	Cursor.Container = Container;
+	Cursor.ElementProperty = ElementProperty;
+	Iterable->IterableBegin( Cursor );
+}
+
+bool UCoreTechIterationLibrary::Generic_IterableCursor_Next( FCoreTechIterableCursor &Cursor, void *Element )
+{
+	const auto Iterable = Cast< ICoreTechIterable >( Cursor.Container.Get( ) );
+	if (Iterable == nullptr)
+		return false;
+
+	const auto Current = Iterable->IterableCurrent( Cursor );
+	if (Current == nullptr)
+	{
+		Cursor.Container = nullptr;
+		return false;
+	}
+
+	// Read the element straight out of the container storage, as the type that was checked when the cursor was prepared
+	if (Element != nullptr)
+		Cursor.ElementProperty->CopyCompleteValue( Element, Current );
+
+	// Step past the element before the loop body runs, the same as the actor cursor does
+	Iterable->IterableAdvance( Cursor );
+	return true;
+}
+
+void UCoreTechIterationLibrary::IterableCursor_End( FCoreTechIterableCursor &Cursor )
+{
+	Cursor.Container = nullptr;
+}
+
+bool UCoreTechIterationLibrary::DataTable_NextRow( const UDataTable *DataTable, int32 &Cursor, FName &RowName )
+{
+	RowName = NAME_None;
+
+	if (DataTable == nullptr)
+		return false;
+
+	// Walk the row storage in place instead of snapshotting the row names and looking each one up
+	const auto &RowMap = DataTable->GetRowMap( );
+	const auto MaxIndex = RowMap.GetMaxIndex( );
+
+	// A cursor that has been broken out of the loop is past the end and stays there
+	for (Cursor = (Cursor < MaxIndex) ? FMath::Max( Cursor + 1, 0 ) : MaxIndex; Cursor < MaxIndex; ++Cursor)
+	{
+		const auto Id = FSetElementId::FromInteger( Cursor );
+		if (RowMap.IsValidId( Id ))
+		{
+			RowName = RowMap.Get( Id ).Key;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// Find the row data at the cursor and make sure that it can be read as the type the node expects
+static const uint8* FindRowAtCursor( const UDataTable *DataTable, int32 Cursor )
+{
+	if ((DataTable == nullptr) || (DataTable->RowStruct == nullptr))
+		return nullptr;
+
+	const auto &RowMap = DataTable->GetRowMap( );
+	if ((Cursor < 0) || (Cursor >= RowMap.GetMaxIndex( )))
+		return nullptr;
+
+	const auto Id = FSetElementId::FromInteger( Cursor );
+	if (!RowMap.IsValidId( Id ))
+		return nullptr;
+
+	return RowMap.Get( Id ).Value;
+}
+
+void UCoreTechIterationLibrary::Generic_DataTable_GetRow( const UDataTable *DataTable, int32 Cursor, void *OutRow, const FProperty *OutRowProperty )
+{
+	const auto StructProperty = CastField< FStructProperty >( OutRowProperty );
+	if ((OutRow == nullptr) || (StructProperty == nullptr))
+		return;
+
+	const auto Row = FindRowAtCursor( DataTable, Cursor );
+	if (Row == nullptr)
+		return;
+
+	if (!DataTable->RowStruct->IsChildOf( StructProperty->Struct ))
+	{
+		FFrame::KismetExecutionMessage( *FString::Printf( TEXT( "Rows of data table '%s' can't be read as '%s'." ), *DataTable->GetPathName( ), *StructProperty->Struct->GetName( ) ), ELogVerbosity::Warning );
+		return;
+	}
+
+	StructProperty->Struct->CopyScriptStruct( OutRow, Row );
+}
+
+void UCoreTechIterationLibrary::Generic_DataTable_GetRowMember( const UDataTable *DataTable, int32 Cursor, FName MemberName, void *Value, const FProperty *ValueProperty )
+{
+	if ((Value == nullptr) || (ValueProperty == nullptr))
+		return;
+
+	const auto Row = FindRowAtCursor( DataTable, Cursor );
+	if (Row == nullptr)
+		return;
+
+	const auto Member = FindFProperty< FProperty >( DataTable->RowStruct, MemberName );
+	if ((Member == nullptr) || !Member->SameType( ValueProperty ))
+	{
+		FFrame::KismetExecutionMessage( *FString::Printf( TEXT( "Attempted to get member '%s' that doesn't exist on the rows of data table '%s'." ), *MemberName.ToString( ), *DataTable->GetPathName( ) ), ELogVerbosity::Warning );
+		return;
+	}
+
+	// Read the member straight out of the table storage, as the whole value a pin holds (a bitfield bool is read out of its byte)
+	Member->CopySingleValueToScriptVM( Value, Member->ContainerPtrToValuePtr< void >( Row ) );
+}
@@ -0,0 +1,194 @@
+
+#pragma once
+
+#include "Kismet/BlueprintFunctionLibrary.h"
+
+// Engine
+#include "Engine/LatentActionManager.h"
+
+#include "CoreTechIterable.h"
+
+#include "CoreTechIterationLibrary.generated.h"
+
+class AActor;
+class UDataTable;
+struct FStreamableHandle;
+struct FTableRowBase;
+
+// Opaque state used by the For Each Actor of Class node to walk the actors of a world one at a time
+USTRUCT( BlueprintType, meta = (BlueprintInternalUseOnly = "true") )
+struct CORETECH_API FCoreTechActorCursor
+{
+	GENERATED_BODY( )
+
+	// The world whose actors are being visited
+	TWeakObjectPtr< UWorld > World;
+
+	// The level currently being walked
+	int32 LevelIndex = 0;
+
+	// The next actor of the current level to check
+	int32 ActorIndex = 0;
+};
+
+// Opaque state used by the Async Load For Each node to stream in an array of soft references a chunk at a time
+USTRUCT( BlueprintType, meta = (BlueprintInternalUseOnly = "true") )
+struct CORETECH_API FCoreTechSoftObjectCursor
+{
+	GENERATED_BODY( )
+
+	// The request for the current chunk, keeps the chunk loaded while it is being visited
+	TSharedPtr< FStreamableHandle > Handle;
+
+	// The request for the chunk after the current one, which loads while the current chunk is being visited
+	TSharedPtr< FStreamableHandle > NextHandle;
+
+	// The first index past the end of the current chunk
+	int32 ChunkEnd = 0;
+
+	// The first index past the end of the chunk after the current one
+	int32 NextChunkEnd = 0;
+
+	// The element of the current chunk that was visited last
+	int32 Index = INDEX_NONE;
+};
+
+// Native support functions for the custom iteration K2 nodes
+UCLASS( )
+class CORETECH_API UCoreTechIterationLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY( )
+public:
+	// Prepare a cursor to walk the actors of the world
+	UFUNCTION( BlueprintCallable, meta = (BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject") )
+	static void ActorCursor_Begin( const UObject *WorldContextObject, UPARAM( ref ) FCoreTechActorCursor &Cursor );
+
+	// Step the cursor to the next live actor of the class, returning false once there are no more
+	UFUNCTION( BlueprintCallable, meta = (BlueprintInternalUseOnly = "true") )
+	static bool ActorCursor_Next( UPARAM( ref ) FCoreTechActorCursor &Cursor, TSubclassOf< AActor > ActorClass, AActor *&Actor );
+
+	// Exhaust the cursor so that the next step will report there are no more actors
+	UFUNCTION( BlueprintCallable, meta = (BlueprintInternalUseOnly = "true") )
+	static void ActorCursor_End( UPARAM( ref ) FCoreTechActorCursor &Cursor );
+
+	// Prepare a cursor to stream in an array, cancelling anything left over from a previous run
+	UFUNCTION( BlueprintCallable, meta = (BlueprintInternalUseOnly = "true") )
+	static void SoftObjectCursor_Begin( UPARAM( ref ) FCoreTechSoftObjectCursor &Cursor );
+
+	// Move on to the next chunk of the array, returning false once there are no more. Each chunk is requested as a single batch
+	// while the chunk before it is being visited. Chunk sizes of zero or less request everything at once.
+	UFUNCTION( BlueprintCallable, meta = (BlueprintInternalUseOnly = "true") )
+	static bool SoftObjectCursor_RequestChunk( const TArray< TSoftObjectPtr< UObject > > &SoftObjects, int32 ChunkSize, UPARAM( ref ) FCoreTechSoftObjectCursor &Cursor, bool &bLoaded );
+
+	// Wait for the current chunk to finish loading
+	UFUNCTION( BlueprintCallable, meta = (BlueprintInternalUseOnly = "true", Latent, LatentInfo = "LatentInfo", WorldContext = "WorldContextObject") )
+	static void SoftObjectCursor_WaitForChunk( const UObject *WorldContextObject, const FCoreTechSoftObjectCursor &Cursor, FLatentActionInfo LatentInfo );
+
+	// Step the cursor to the next element of the current chunk, returning false once the chunk has been visited
+	UFUNCTION( BlueprintCallable, meta = (BlueprintInternalUseOnly = "true") )
+	static bool SoftObjectCursor_Next( UPARAM( ref ) FCoreTechSoftObjectCursor &Cursor, int32 &Index );
+
+	// Cancel any outstanding request and exhaust the cursor so that there will be no more chunks
+	UFUNCTION( BlueprintCallable, meta = (BlueprintInternalUseOnly = "true") )
+	static void SoftObjectCursor_End( UPARAM( ref ) FCoreTechSoftObjectCursor &Cursor );
+
+	// Resolve the element of the array, without loading it
+	UFUNCTION( BlueprintPure, meta = (BlueprintInternalUseOnly = "true") )
+	static UObject* SoftObjectCursor_Get( const TArray< TSoftObjectPtr< UObject > > &SoftObjects, int32 Index );
+
+	// Prepare a cursor to walk the elements of an iterable container, which are read as the type of Element (only its type is used)
+	UFUNCTION( BlueprintCallable, CustomThunk, meta = (BlueprintInternalUseOnly = "true", CustomStructureParam = "Element") )
+	static void IterableCursor_Begin( UObject *Container, UPARAM( ref ) FCoreTechIterableCursor &Cursor, const int32 &Element );
+
+	// Copy the element at the cursor and step past it, returning false once there are no more
+	UFUNCTION( BlueprintCallable, CustomThunk, meta = (BlueprintInternalUseOnly = "true", CustomStructureParam = "Element") )
+	static bool IterableCursor_Next( UPARAM( ref ) FCoreTechIterableCursor &Cursor, int32 &Element );
+
+	// Exhaust the cursor so that the next step will report there are no more elements
+	UFUNCTION( BlueprintCallable, meta = (BlueprintInternalUseOnly = "true") )
+	static void IterableCursor_End( UPARAM( ref ) FCoreTechIterableCursor &Cursor );
+
+	// Step the cursor to the next row of the table (start from INDEX_NONE), returning false once there are no more
+	UFUNCTION( BlueprintCallable, meta = (BlueprintInternalUseOnly = "true") )
+	static bool DataTable_NextRow( const UDataTable *DataTable, UPARAM( ref ) int32 &Cursor, FName &RowName );
+
+	// Copy the row at the cursor
+	UFUNCTION( BlueprintPure, CustomThunk, meta = (BlueprintInternalUseOnly = "true", CustomStructureParam = "OutRow") )
+	static void DataTable_GetRow( const UDataTable *DataTable, int32 Cursor, FTableRowBase &OutRow );
+
+	// Copy a single member out of the row at the cursor, reading it straight from the table without copying the rest of the row
+	UFUNCTION( BlueprintPure, CustomThunk, meta = (BlueprintInternalUseOnly = "true", CustomStructureParam = "Value") )
+	static void DataTable_GetRowMember( const UDataTable *DataTable, int32 Cursor, FName MemberName, int32 &Value );
+
+	// Native implementations of the custom thunks
+	static void Generic_DataTable_GetRow( const UDataTable *DataTable, int32 Cursor, void *OutRow, const FProperty *OutRowProperty );
+	static void Generic_DataTable_GetRowMember( const UDataTable *DataTable, int32 Cursor, FName MemberName, void *Value, const FProperty *ValueProperty );
+	static void Generic_IterableCursor_Begin( UObject *Container, FCoreTechIterableCursor &Cursor, const FProperty *ElementProperty );
+	static bool Generic_IterableCursor_Next( FCoreTechIterableCursor &Cursor, void *Element );
+
+	DECLARE_FUNCTION( execIterableCursor_Begin )
+	{
+		P_GET_OBJECT( UObject, Container );
+		P_GET_STRUCT_REF( FCoreTechIterableCursor, Cursor );
+
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn< FProperty >( nullptr );
+		const auto ElementProperty = Stack.MostRecentProperty;
+
+		P_FINISH;
+
+		P_NATIVE_BEGIN;
+		Generic_IterableCursor_Begin( Container, Cursor, ElementProperty );
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION( execIterableCursor_Next )
+	{
+		P_GET_STRUCT_REF( FCoreTechIterableCursor, Cursor );
+
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn< FProperty >( nullptr );
+		void *ElementAddr = Stack.MostRecentPropertyAddress;
+
+		P_FINISH;
+
+		P_NATIVE_BEGIN;
+		*(bool*)RESULT_PARAM = Generic_IterableCursor_Next( Cursor, ElementAddr );
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION( execDataTable_GetRow )
+	{
+		P_GET_OBJECT( UDataTable, DataTable );
+		P_GET_PROPERTY( FIntProperty, Cursor );
+
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn< FProperty >( nullptr );
+		void *OutRowAddr = Stack.MostRecentPropertyAddress;
+		const auto OutRowProperty = Stack.MostRecentProperty;
+
+		P_FINISH;
+
+		P_NATIVE_BEGIN;
+		Generic_DataTable_GetRow( DataTable, Cursor, OutRowAddr, OutRowProperty );
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION( execDataTable_GetRowMember )
+	{
+		P_GET_OBJECT( UDataTable, DataTable );
+		P_GET_PROPERTY( FIntProperty, Cursor );
+		P_GET_PROPERTY( FNameProperty, MemberName );
+
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn< FProperty >( nullptr );
+		void *ValueAddr = Stack.MostRecentPropertyAddress;
+		const auto ValueProperty = Stack.MostRecentProperty;
+
+		P_FINISH;
+
+		P_NATIVE_BEGIN;
+		Generic_DataTable_GetRowMember( DataTable, Cursor, MemberName, ValueAddr, ValueProperty );
+		P_NATIVE_END;
+	}
+};
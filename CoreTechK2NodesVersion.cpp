@@ -0,0 +1,10 @@
+
+#include "CoreTechK2NodesVersion.h"
+
+// Core
+#include "Serialization/CustomVersion.h"
+
+const FGuid FCoreTechK2NodesVersion::GUID( 0x6A1C4E02, 0x3F8B4D71, 0x9E25B7C4, 0x5D0F18A3 );
+
+// Register the custom version with core
+FCustomVersionRegistration GRegisterCoreTechK2NodesVersion( FCoreTechK2NodesVersion::GUID, FCoreTechK2NodesVersion::LatestVersion, TEXT( "CoreTechK2NodesVer" ) );
@@ -0,0 +1,27 @@
+
+#pragma once
+
+#include "Misc/Guid.h"
+
+// Custom serialization version for the K2 nodes in this module
+struct CORETECHDEVELOPER_API FCoreTechK2NodesVersion
+{
+	enum Type
+	{
+		// Before any version changes were made
+		BeforeCustomVersionWasAdded = 0,
+
+		// Resolved wildcard pin types are no longer saved on the node, they're recovered from the node's own pins instead
+		CompactWildcardPinTypes,
+
+		// -----<new versions can be added above this line>-------------------------------------------------
+		VersionPlusOne,
+		LatestVersion = VersionPlusOne - 1
+	};
+
+	// The GUID for this custom version number
+	const static FGuid GUID;
+
+private:
+	FCoreTechK2NodesVersion( ) = default;
+};
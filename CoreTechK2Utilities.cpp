@@ -12,6 +12,7 @@
 
 // Engine
 #include "EdGraph/EdGraphPin.h"
+#include "Engine/Blueprint.h"
 #include "Kismet2/BlueprintEditorUtils.h"
 
 // GraphEditor
@@ -31,20 +32,76 @@ void CoreTechK2Utilities::MovePinLinksOrCopyDefaults( FKismetCompilerContext &Co
 	}
 }
 
+void CoreTechK2Utilities::CopyPinLinksOrDefaults( FKismetCompilerContext &CompilerContext, UEdGraphPin *Source, UEdGraphPin *Dest )
+{
+	if (Source->LinkedTo.Num( ) > 0) // Copy the pin links
+	{
+		CompilerContext.CopyPinLinksToIntermediate( *Source, *Dest );
+	}
+	else // Copy the blueprint literal
+	{
+		Dest->DefaultObject = Source->DefaultObject;
+		Dest->DefaultValue = Source->DefaultValue;
+		Dest->DefaultTextValue = Source->DefaultTextValue;
+	}
+}
+
 void CoreTechK2Utilities::RefreshAllowedConnections( const UK2Node *K2Node, UEdGraphPin *Pin )
 {
 	auto PinConnectionList = Pin->LinkedTo;
 	Pin->BreakAllPinLinks( true );
 
-	const auto K2Schema = GetDefault<UEdGraphSchema_K2>( );
+	const auto K2Schema = CastChecked< UEdGraphSchema_K2 >( K2Node->GetSchema( ) );
 	for (const auto Connection : PinConnectionList)
 	{
 		K2Schema->TryCreateConnection( Pin, Connection );
 	}
 
+	// Nodes reconstructed while compiling (including the copies that get expanded) aren't in the graphs shown in the editor,
+	// and the Blueprint is already being rebuilt
+	const auto Blueprint = K2Node->GetBlueprint( );
+	if ((Blueprint == nullptr) || Blueprint->bBeingCompiled)
+		return;
+
 	K2Node->GetGraph( )->NotifyGraphChanged( );
 
-	FBlueprintEditorUtils::MarkBlueprintAsModified( K2Node->GetBlueprint( ) );
+	FBlueprintEditorUtils::MarkBlueprintAsModified( Blueprint );
+}
+
+const FEdGraphPinType* CoreTechK2Utilities::GetReconstructedPinType( const TArray< UEdGraphPin* > &OldPins, const FName &PinName )
+{
+	const auto OldPin = OldPins.FindByPredicate( [ &PinName ]( const UEdGraphPin *Pin ) { return Pin->PinName == PinName; } );
+	if ((OldPin == nullptr) || ((*OldPin)->PinType.PinCategory == UEdGraphSchema_K2::PC_Wildcard))
+		return nullptr;
+
+	return &(*OldPin)->PinType;
+}
+
+FEdGraphPinType CoreTechK2Utilities::GetWildcardArrayType( )
+{
+	FEdGraphPinType PinType;
+	PinType.PinCategory = UEdGraphSchema_K2::PC_Wildcard;
+	PinType.ContainerType = EPinContainerType::Array;
+	PinType.bIsConst = true;
+	PinType.bIsReference = true;
+
+	return PinType;
+}
+
+bool CoreTechK2Utilities::IsPinTypeStale( const UEdGraphPin *Pin )
+{
+	if (Pin->LinkedTo.Num( ) == 0)
+		return false;
+
+	// Only the type itself matters, not how it's passed
+	const auto &PinType = Pin->PinType;
+	const auto &LinkType = Pin->LinkedTo[ 0 ]->PinType;
+
+	return (PinType.PinCategory != LinkType.PinCategory) || (PinType.PinSubCategory != LinkType.PinSubCategory) ||
+		(PinType.PinSubCategoryObject != LinkType.PinSubCategoryObject) || (PinType.ContainerType != LinkType.ContainerType) ||
+		(PinType.PinValueType.TerminalCategory != LinkType.PinValueType.TerminalCategory) ||
+		(PinType.PinValueType.TerminalSubCategory != LinkType.PinValueType.TerminalSubCategory) ||
+		(PinType.PinValueType.TerminalSubCategoryObject != LinkType.PinValueType.TerminalSubCategoryObject);
 }
 
 void CoreTechK2Utilities::SetPinToolTip( UEdGraphPin *Pin, const FText &PinDescription )
@@ -83,6 +140,129 @@ void CoreTechK2Utilities::DefaultGetMenuActions( const UK2Node *Node, FBlueprint
 	}
 }
 
+void CoreTechK2Utilities::EnumGetMenuActions( const UK2Node *Node, FBlueprintActionDatabaseRegistrar& ActionRegistrar, const UEnum *Enum, TFunction< void( UEdGraphNode*, int64 ) > CustomizeNode )
+{
+	// see DefaultGetMenuActions for the reasoning behind the action key and registration check
+	const auto ActionKey = Node->GetClass( );
+	if (!ActionRegistrar.IsOpenForRegistration( ActionKey ))
+		return;
+
+	// skip the autogenerated _MAX entry
+	for (int idx = 0; idx < Enum->NumEnums( ) - 1; ++idx)
+	{
+		if (Enum->HasMetaData( TEXT( "Hidden" ), idx ))
+			continue;
+
+		const auto NodeSpawner = UBlueprintNodeSpawner::Create( ActionKey );
+		check( NodeSpawner != nullptr );
+
+		const auto Value = Enum->GetValueByIndex( idx );
+		NodeSpawner->CustomizeNodeDelegate = UBlueprintNodeSpawner::FCustomizeNodeDelegate::CreateLambda( [ CustomizeNode, Value ]( UEdGraphNode *NewNode, bool bIsTemplateNode )
+		{
+			CustomizeNode( NewNode, Value );
+		} );
+
+		ActionRegistrar.AddBlueprintAction( ActionKey, NodeSpawner );
+	}
+}
+
+UScriptStruct* CoreTechK2Utilities::GetPinTypeStruct( const FEdGraphPinType &PinType )
+{
+	if (PinType.PinCategory != UEdGraphSchema_K2::PC_Struct)
+		return nullptr;
+
+	return Cast< UScriptStruct >( PinType.PinSubCategoryObject.Get( ) );
+}
+
+FName CoreTechK2Utilities::GetStructMemberPinName( const FName &ParentPinName, const FProperty *Member )
+{
+	// Can't use the '_' separator that split struct pins use or we would collide with them when the parent pin is split
+	return FName( *FString::Printf( TEXT( "%s:%s" ), *ParentPinName.ToString( ), *Member->GetName( ) ) );
+}
+
+TArray< FProperty* > CoreTechK2Utilities::GetProjectableStructMembers( const UEdGraphSchema_K2 *K2Schema, const UScriptStruct *Struct )
+{
+	TArray< FProperty* > Members;
+
+	if (Struct == nullptr)
+		return Members;
+
+	for (TFieldIterator< FProperty > It( Struct ); It; ++It)
+	{
+		const auto Member = *It;
+
+		if (!Member->HasAnyPropertyFlags( CPF_BlueprintVisible ) || Member->HasAnyPropertyFlags( CPF_Deprecated ))
+			continue;
+
+		FEdGraphPinType MemberType;
+		if (!K2Schema->ConvertPropertyToPinType( Member, MemberType ))
+			continue;
+
+		Members.Add( Member );
+	}
+
+	return Members;
+}
+
+TArray< UEdGraphPin* > CoreTechK2Utilities::RefreshStructMemberPins( UK2Node *Node, UEdGraphPin *ParentPin, bool bCreatePins )
+{
+	const auto K2Schema = CastChecked< UEdGraphSchema_K2 >( Node->GetSchema( ) );
+
+	// Work out the member pins that the parent pin should have with its current type
+	TArray< FProperty* > Members;
+	const auto Struct = GetPinTypeStruct( ParentPin->PinType );
+	if (bCreatePins && (Struct != nullptr) && !ParentPin->PinType.IsContainer( ))
+		Members = GetProjectableStructMembers( K2Schema, Struct );
+
+	TMap< FName, FEdGraphPinType > MemberTypes;
+	for (const auto Member : Members)
+	{
+		FEdGraphPinType MemberType;
+		K2Schema->ConvertPropertyToPinType( Member, MemberType );
+		MemberTypes.Add( GetStructMemberPinName( ParentPin->PinName, Member ), MemberType );
+	}
+
+	// Only remove the member pins that no longer match, so the connections of the rest survive the parent pin changing source
+	const auto ParentPrefix = ParentPin->PinName.ToString( ) + TEXT( ":" );
+	for (int idx = Node->Pins.Num( ) - 1; idx >= 0; --idx)
+	{
+		const auto Pin = Node->Pins[ idx ];
+		if (!Pin->PinName.ToString( ).StartsWith( ParentPrefix ))
+			continue;
+
+		const auto MemberType = MemberTypes.Find( Pin->PinName );
+		if ((MemberType != nullptr) && (*MemberType == Pin->PinType))
+			continue;
+
+		Pin->BreakAllPinLinks( true );
+		Node->RemovePin( Pin );
+	}
+
+	TArray< UEdGraphPin* > MemberPins;
+
+	// Keep the members grouped with the pin they're projected from, in the order the struct declares them
+	int PinIndex = Node->Pins.Find( ParentPin );
+	for (const auto Member : Members)
+	{
+		const auto MemberPinName = GetStructMemberPinName( ParentPin->PinName, Member );
+
+		auto MemberPin = Node->FindPin( MemberPinName, ParentPin->Direction );
+		if (MemberPin == nullptr)
+		{
+			MemberPin = Node->CreatePin( ParentPin->Direction, MemberTypes[ MemberPinName ], MemberPinName, PinIndex + 1 );
+			MemberPin->PinFriendlyName = Member->GetDisplayNameText( );
+			SetPinToolTip( MemberPin, Member->GetToolTipText( ) );
+		}
+
+		MemberPin->bAdvancedView = ParentPin->bAdvancedView;
+		PinIndex = Node->Pins.Find( MemberPin );
+
+		MemberPins.Add( MemberPin );
+	}
+
+	return MemberPins;
+}
+
 FSlateIcon CoreTechK2Utilities::GetFunctionIconAndTint( FLinearColor& OutColor )
 {
 	OutColor = GetDefault< UGraphEditorSettings >( )->FunctionCallNodeTitleColor;
@@ -6,6 +6,8 @@ class UEdGraphPin;
 class UK2Node;
 class FBlueprintActionDatabaseRegistrar;
 class UK2Node_CustomEvent;
+class UScriptStruct;
+class UEdGraphSchema_K2;
 
 // Utilities for writing custom K2 nodes
 namespace CoreTechK2Utilities
@@ -17,9 +19,24 @@ namespace CoreTechK2Utilities
 	// Handle the copy of data from one pin to another either moving the links or copying the default value data
 	CORETECHDEVELOPER_API void MovePinLinksOrCopyDefaults( FKismetCompilerContext &CompilerContext, UEdGraphPin *Source, UEdGraphPin *Dest );
 
-	// Forcibly detach and attempt to reattach all the links from the pin to other pins
+	// Handle the copy of data from one pin to another either copying the links or copying the default value data
+	CORETECHDEVELOPER_API void CopyPinLinksOrDefaults( FKismetCompilerContext &CompilerContext, UEdGraphPin *Source, UEdGraphPin *Dest );
+
+	// Forcibly detach and attempt to reattach all the links from the pin to other pins.
+	// The editor is only notified about the change when the Blueprint isn't being compiled.
 	CORETECHDEVELOPER_API void RefreshAllowedConnections( const UK2Node *K2Node, UEdGraphPin *Pin );
 
+	// Find the resolved type that a pin had before the node was reconstructed, or null if the pin was still a wildcard.
+	// Lets nodes recover the types of their wildcard pins without saving them separately from the pins.
+	UE_NODISCARD CORETECHDEVELOPER_API const FEdGraphPinType* GetReconstructedPinType( const TArray< UEdGraphPin* > &OldPins, const FName &PinName );
+
+	// The type for array input pins that take on the type of whatever they're connected to
+	UE_NODISCARD CORETECHDEVELOPER_API FEdGraphPinType GetWildcardArrayType( );
+
+	// Whether the type of a pin no longer agrees with the pin it's linked to, like after a paste into a graph with different variable types.
+	// Pins without any links are never stale, a pasted node keeps the type it was copied with.
+	UE_NODISCARD CORETECHDEVELOPER_API bool IsPinTypeStale( const UEdGraphPin *Pin );
+
 	// Get the pin that is acting as an input to the specified pin
 	UE_NODISCARD CORETECHDEVELOPER_API UEdGraphPin* GetInputPinLink( UEdGraphPin *Pin );
 
@@ -29,6 +46,9 @@ namespace CoreTechK2Utilities
 	// Utility function wrapping the bare minimum code needed for implementing overrides of UK2Node::GetMenuActions
 	CORETECHDEVELOPER_API void DefaultGetMenuActions( const UK2Node *Node, FBlueprintActionDatabaseRegistrar& ActionRegistrar );
 
+	// Utility for registering a separate menu action for each value of an enum, letting the node configure itself for that value
+	CORETECHDEVELOPER_API void EnumGetMenuActions( const UK2Node *Node, FBlueprintActionDatabaseRegistrar& ActionRegistrar, const UEnum *Enum, TFunction< void( UEdGraphNode*, int64 ) > CustomizeNode );
+
 	// Utility for creating event nodes that can be used to bind BlueprintInternal function delegate params to custom k2node exec output pins
 	CORETECHDEVELOPER_API UK2Node_CustomEvent* CreateCustomEvent( FKismetCompilerContext &CompilerContext, UEdGraphPin *SourcePin, UEdGraph *SourceGraph, UK2Node *Node, UEdGraphPin *ExternalPin );
 
@@ -49,6 +69,18 @@ namespace CoreTechK2Utilities
 	// Attach pins created by CreateEventDispatcherPins to the object
 	UE_NODISCARD CORETECHDEVELOPER_API UEdGraphPin* ExpandDispatcherPins( FKismetCompilerContext &CompilerContext, UEdGraph *SourceGraph, UK2Node *Node, UEdGraphPin *ExecPin, UClass *Class, UEdGraphPin *InstancePin, TFunction< bool( UEdGraphPin* ) > IsGeneratedPin );
 
+	// Get the struct type of a pin type, or null if the type isn't a struct
+	UE_NODISCARD CORETECHDEVELOPER_API UScriptStruct* GetPinTypeStruct( const FEdGraphPinType &PinType );
+
+	// Build the name of the pin that projects a single member of a struct pin
+	UE_NODISCARD CORETECHDEVELOPER_API FName GetStructMemberPinName( const FName &ParentPinName, const FProperty *Member );
+
+	// Find all the members of a struct that can be projected as pins
+	UE_NODISCARD CORETECHDEVELOPER_API TArray< FProperty* > GetProjectableStructMembers( const UEdGraphSchema_K2 *K2Schema, const UScriptStruct *Struct );
+
+	// Bring the member pins of the parent pin in line with its current struct type (or remove them all), keeping the pins that still match along with their links
+	CORETECHDEVELOPER_API TArray< UEdGraphPin* > RefreshStructMemberPins( UK2Node *Node, UEdGraphPin *ParentPin, bool bCreatePins );
+
 	// Change the order of a pin within the Node pins
 	CORETECHDEVELOPER_API void ReorderPin( UK2Node *Node, UEdGraphPin *Pin, int NewIndex );
 
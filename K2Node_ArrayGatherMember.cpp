@@ -0,0 +1,257 @@
+
+#include "K2Nodes/K2Node_ArrayGatherMember.h"
+
+#include "CoreTechArrayLibrary.h"
+#include "CoreTechK2Utilities.h"
+
+// BlueprintGraph
+#include "K2Node_CallFunction.h"
+
+// KismetCompiler
+#include "KismetCompiler.h"
+
+// UnrealEd
+#include "Kismet2/BlueprintEditorUtils.h"
+
+#define LOCTEXT_NAMESPACE "K2Node_ArrayGatherMember"
+
+const FName UK2Node_ArrayGatherMember::ArrayPinName( TEXT( "ArrayPin" ) );
+const FName UK2Node_ArrayGatherMember::ResultPinName( TEXT( "ResultPin" ) );
+
+// Arrays of containers aren't something that Blueprints can have, so those members can't be gathered
+static bool IsGatherableMember( const FProperty *Member )
+{
+	return !Member->IsA< FArrayProperty >( ) && !Member->IsA< FSetProperty >( ) && !Member->IsA< FMapProperty >( );
+}
+
+void UK2Node_ArrayGatherMember::AllocateDefaultPins( )
+{
+	Super::AllocateDefaultPins( );
+
+	const auto ArrayPin = CreatePin( EGPD_Input, CoreTechK2Utilities::GetWildcardArrayType( ), ArrayPinName );
+	ArrayPin->PinFriendlyName = LOCTEXT( "ArrayPin_FriendlyName", "Array" );
+
+	const auto ResultPin = CreatePin( EGPD_Output, UEdGraphSchema_K2::PC_Wildcard, ResultPinName );
+	ResultPin->PinType.ContainerType = EPinContainerType::Array;
+	ResultPin->PinFriendlyName = LOCTEXT( "ResultPin_FriendlyName", "Result" );
+
+	SetArrayType( CoreTechK2Utilities::GetWildcardArrayType( ) );
+}
+
+void UK2Node_ArrayGatherMember::ReallocatePinsDuringReconstruction( TArray< UEdGraphPin* > &OldPins )
+{
+	Super::ReallocatePinsDuringReconstruction( OldPins );
+
+	if (const auto OldArrayType = CoreTechK2Utilities::GetReconstructedPinType( OldPins, ArrayPinName ))
+		SetArrayType( *OldArrayType );
+}
+
+void UK2Node_ArrayGatherMember::PostPasteNode( )
+{
+	Super::PostPasteNode( );
+
+	if (CoreTechK2Utilities::IsPinTypeStale( GetArrayPin( ) ))
+		PinConnectionListChanged( GetArrayPin( ) );
+}
+
+#if WITH_EDITOR
+void UK2Node_ArrayGatherMember::PostEditChangeProperty( FPropertyChangedEvent &PropertyChangedEvent )
+{
+	Super::PostEditChangeProperty( PropertyChangedEvent );
+
+	if (PropertyChangedEvent.GetPropertyName( ) == GET_MEMBER_NAME_CHECKED( UK2Node_ArrayGatherMember, MemberName ))
+	{
+		SetArrayType( GetArrayPin( )->PinType );
+		CoreTechK2Utilities::RefreshAllowedConnections( this, GetResultPin( ) );
+
+		// Poke the graph to update the visuals based on the above changes
+		GetGraph( )->NotifyGraphChanged( );
+		FBlueprintEditorUtils::MarkBlueprintAsModified( GetBlueprint( ) );
+	}
+}
+#endif
+
+void UK2Node_ArrayGatherMember::SetArrayType( const FEdGraphPinType &ArrayType )
+{
+	const auto ArrayPin = GetArrayPin( );
+	ArrayPin->PinType = ArrayType;
+	CoreTechK2Utilities::SetPinToolTip( ArrayPin, LOCTEXT( "ArrayPin_Tooltip", "Array of structs to gather the member from" ) );
+
+	// The result stays a wildcard until there is a member to gather
+	FEdGraphPinType ResultType;
+	ResultType.PinCategory = UEdGraphSchema_K2::PC_Wildcard;
+
+	const auto K2Schema = CastChecked< UEdGraphSchema_K2 >( GetSchema( ) );
+	if (const auto Member = FindMember( ))
+		K2Schema->ConvertPropertyToPinType( Member, ResultType );
+
+	ResultType.ContainerType = EPinContainerType::Array;
+
+	const auto ResultPin = GetResultPin( );
+	ResultPin->PinType = ResultType;
+	CoreTechK2Utilities::SetPinToolTip( ResultPin, LOCTEXT( "ResultPin_Tooltip", "The member of every element of the array, in the same order" ) );
+}
+
+const FProperty* UK2Node_ArrayGatherMember::FindMember( ) const
+{
+	if (MemberName.IsNone( ))
+		return nullptr;
+
+	const auto K2Schema = CastChecked< UEdGraphSchema_K2 >( GetSchema( ) );
+	for (const auto Member : CoreTechK2Utilities::GetProjectableStructMembers( K2Schema, CoreTechK2Utilities::GetPinTypeStruct( GetArrayPin( )->PinType ) ))
+	{
+		if ((Member->GetFName( ) == MemberName) && IsGatherableMember( Member ))
+			return Member;
+	}
+
+	return nullptr;
+}
+
+TArray< FString > UK2Node_ArrayGatherMember::GetMemberNameOptions( ) const
+{
+	TArray< FString > Options;
+
+	const auto K2Schema = CastChecked< UEdGraphSchema_K2 >( GetSchema( ) );
+	for (const auto Member : CoreTechK2Utilities::GetProjectableStructMembers( K2Schema, CoreTechK2Utilities::GetPinTypeStruct( GetArrayPin( )->PinType ) ))
+	{
+		if (IsGatherableMember( Member ))
+			Options.Add( Member->GetName( ) );
+	}
+
+	return Options;
+}
+
+void UK2Node_ArrayGatherMember::ExpandNode( FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph )
+{
+	Super::ExpandNode( CompilerContext, SourceGraph );
+
+	if (CheckForErrors( CompilerContext ))
+	{
+		// remove all the links to this node as they are no longer needed
+		BreakAllNodeLinks( );
+		return;
+	}
+
+	const auto ArrayPin = GetArrayPin( );
+	const auto ResultPin = GetResultPin( );
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// Call the native gather, no loop required
+	const auto CallGather = CompilerContext.SpawnIntermediateNode< UK2Node_CallFunction >( this, SourceGraph );
+	CallGather->FunctionReference.SetExternalMember( GET_FUNCTION_NAME_CHECKED( UCoreTechArrayLibrary, Array_GatherMember ), UCoreTechArrayLibrary::StaticClass( ) );
+	CallGather->AllocateDefaultPins( );
+
+	const auto Gather_Array = CallGather->FindPinChecked( TEXT( "TargetArray" ) );
+	const auto Gather_MemberName = CallGather->FindPinChecked( TEXT( "MemberName" ) );
+	const auto Gather_Result = CallGather->FindPinChecked( TEXT( "Result" ) );
+
+	// Coerce the wildcard pin types
+	Gather_Array->PinType = ArrayPin->PinType;
+	Gather_Result->PinType = ResultPin->PinType;
+
+	CompilerContext.MovePinLinksToIntermediate( *ArrayPin, *Gather_Array );
+	Gather_MemberName->DefaultValue = MemberName.ToString( );
+	CompilerContext.MovePinLinksToIntermediate( *ResultPin, *Gather_Result );
+
+	///////////////////////////////////////////////////////////////////////////////////
+	//
+	BreakAllNodeLinks( );
+}
+
+bool UK2Node_ArrayGatherMember::CheckForErrors( const FKismetCompilerContext& CompilerContext )
+{
+	bool bError = false;
+
+	if (GetArrayPin( )->LinkedTo.Num( ) == 0)
+	{
+		CompilerContext.MessageLog.Error( *LOCTEXT( "MissingArray_Error", "Gather member node @@ must have an array to gather from." ).ToString( ), this );
+		bError = true;
+	}
+	else if (FindMember( ) == nullptr)
+	{
+		CompilerContext.MessageLog.Error( *FText::Format( LOCTEXT( "MissingMember_Error", "Gather member node @@ can't gather '{0}' from the elements of the array." ), FText::FromName( MemberName ) ).ToString( ), this );
+		bError = true;
+	}
+
+	return bError;
+}
+
+bool UK2Node_ArrayGatherMember::IsConnectionDisallowed( const UEdGraphPin* MyPin, const UEdGraphPin* OtherPin, FString& OutReason ) const
+{
+	if (MyPin->PinName == ArrayPinName)
+	{
+		if ((OtherPin->PinType.PinCategory != UEdGraphSchema_K2::PC_Wildcard) && (OtherPin->PinType.PinCategory != UEdGraphSchema_K2::PC_Struct))
+		{
+			OutReason = LOCTEXT( "InvalidType_Reason", "Members can only be gathered from arrays of structs." ).ToString( );
+			return true;
+		}
+	}
+	else if (MyPin->PinName == ResultPinName)
+	{
+		if (FindMember( ) == nullptr)
+		{
+			OutReason = LOCTEXT( "NoMember_Reason", "Connect an array and pick the member to gather before using the result." ).ToString( );
+			return true;
+		}
+	}
+
+	return Super::IsConnectionDisallowed( MyPin, OtherPin, OutReason );
+}
+
+void UK2Node_ArrayGatherMember::PinConnectionListChanged( UEdGraphPin* Pin )
+{
+	Super::PinConnectionListChanged( Pin );
+
+	if (Pin == nullptr)
+		return;
+
+	if (Pin->PinName == ArrayPinName)
+	{
+		if (Pin->LinkedTo.Num( ) > 0)
+			SetArrayType( Pin->LinkedTo[ 0 ]->PinType );
+		else
+			SetArrayType( CoreTechK2Utilities::GetWildcardArrayType( ) );
+
+		CoreTechK2Utilities::RefreshAllowedConnections( this, GetResultPin( ) );
+	}
+}
+
+UEdGraphPin* UK2Node_ArrayGatherMember::GetArrayPin( void ) const
+{
+	return FindPinChecked( ArrayPinName );
+}
+
+UEdGraphPin* UK2Node_ArrayGatherMember::GetResultPin( void ) const
+{
+	return FindPinChecked( ResultPinName );
+}
+
+FText UK2Node_ArrayGatherMember::GetNodeTitle( ENodeTitleType::Type TitleType ) const
+{
+	if ((TitleType == ENodeTitleType::FullTitle) && !MemberName.IsNone( ))
+		return FText::Format( LOCTEXT( "NodeTitle_Member", "Gather {0} (Native)" ), FText::FromName( MemberName ) );
+
+	return LOCTEXT( "NodeTitle", "Gather Member (Native)" );
+}
+
+FText UK2Node_ArrayGatherMember::GetTooltipText( ) const
+{
+	return LOCTEXT( "NodeToolTip", "Copy one member out of every element of an array of structs into a new array, without copying the rest of each element" );
+}
+
+FText UK2Node_ArrayGatherMember::GetMenuCategory( ) const
+{
+	return LOCTEXT( "NodeMenu", "Core Utilities" );
+}
+
+FSlateIcon UK2Node_ArrayGatherMember::GetIconAndTint( FLinearColor& OutColor ) const
+{
+	return CoreTechK2Utilities::GetPureFunctionIconAndTint( OutColor );
+}
+
+void UK2Node_ArrayGatherMember::GetMenuActions( FBlueprintActionDatabaseRegistrar& ActionRegistrar ) const
+{
+	CoreTechK2Utilities::DefaultGetMenuActions( this, ActionRegistrar );
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,62 @@
+
+#pragma once
+
+#include "K2Node.h"
+
+#include "K2Node_ArrayGatherMember.generated.h"
+
+UCLASS( )
+class CORETECHDEVELOPER_API UK2Node_ArrayGatherMember : public UK2Node
+{
+	GENERATED_BODY( )
+public:
+
+	// Pin Accessors
+	UE_NODISCARD UEdGraphPin* GetArrayPin( void ) const;
+	UE_NODISCARD UEdGraphPin* GetResultPin( void ) const;
+
+	// K2Node API
+	UE_NODISCARD bool IsNodePure( ) const override { return true; }
+	UE_NODISCARD bool IsNodeSafeToIgnore( ) const override { return true; }
+	void GetMenuActions( FBlueprintActionDatabaseRegistrar& ActionRegistrar ) const override;
+	UE_NODISCARD FText GetMenuCategory( ) const override;
+	UE_NODISCARD bool IsConnectionDisallowed( const UEdGraphPin* MyPin, const UEdGraphPin* OtherPin, FString& OutReason ) const override;
+
+	// EdGraphNode API
+	void AllocateDefaultPins( ) override;
+	void ExpandNode( FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph ) override;
+	UE_NODISCARD FText GetNodeTitle( ENodeTitleType::Type TitleType ) const override;
+	UE_NODISCARD FText GetTooltipText( ) const override;
+	UE_NODISCARD FSlateIcon GetIconAndTint( FLinearColor& OutColor ) const override;
+	void PinConnectionListChanged( UEdGraphPin* Pin ) override;
+	bool ShouldShowNodeProperties( ) const override { return true; }
+	void PostPasteNode( ) override;
+	void ReallocatePinsDuringReconstruction( TArray< UEdGraphPin* > &OldPins ) override;
+
+	// Object API
+#if WITH_EDITOR
+	void PostEditChangeProperty( FPropertyChangedEvent &PropertyChangedEvent ) override;
+#endif
+
+private:
+	// Pin Names
+	static const FName ArrayPinName;
+	static const FName ResultPinName;
+
+	// Determine if there is any configuration options that shouldn't be allowed
+	UE_NODISCARD bool CheckForErrors( const FKismetCompilerContext& CompilerContext );
+
+	// Update the type of the array pin and the result pin to match
+	void SetArrayType( const FEdGraphPinType &ArrayType );
+
+	// Find the member of the array elements that is being gathered, if it exists
+	UE_NODISCARD const FProperty* FindMember( ) const;
+
+	// The members of the current element type that can be gathered, for the details panel
+	UFUNCTION( )
+	TArray< FString > GetMemberNameOptions( ) const;
+
+	// Which member of the array elements to gather
+	UPROPERTY( EditDefaultsOnly, meta = (GetOptions = "GetMemberNameOptions") )
+	FName MemberName;
+};
@@ -0,0 +1,297 @@
+
+#include "K2Nodes/K2Node_ArrayReduce.h"
+
+#include "CoreTechArrayLibrary.h"
+#include "CoreTechK2Utilities.h"
+
+// BlueprintGraph
+#include "K2Node_CallFunction.h"
+
+// KismetCompiler
+#include "KismetCompiler.h"
+
+#define LOCTEXT_NAMESPACE "K2Node_ArrayReduce"
+
+const FName UK2Node_ArrayReduce::ArrayPinName( TEXT( "ArrayPin" ) );
+const FName UK2Node_ArrayReduce::OtherArrayPinName( TEXT( "OtherArrayPin" ) );
+const FName UK2Node_ArrayReduce::ResultPinName( TEXT( "ResultPin" ) );
+
+// Index into the native function table for the element types that can be reduced
+static int GetNumericTypeIndex( const FEdGraphPinType &PinType )
+{
+	if (PinType.PinCategory == UEdGraphSchema_K2::PC_Int)
+		return 0;
+
+	if (PinType.PinCategory == UEdGraphSchema_K2::PC_Real)
+	{
+		if (PinType.PinSubCategory == UEdGraphSchema_K2::PC_Float)
+			return 1;
+		if (PinType.PinSubCategory == UEdGraphSchema_K2::PC_Double)
+			return 2;
+	}
+
+	return INDEX_NONE;
+}
+
+void UK2Node_ArrayReduce::AllocateDefaultPins( )
+{
+	Super::AllocateDefaultPins( );
+
+	const bool bIsDot = (Reduction == ECoreTechArrayReduction::Dot);
+
+	const auto ArrayPin = CreatePin( EGPD_Input, CoreTechK2Utilities::GetWildcardArrayType( ), ArrayPinName );
+	ArrayPin->PinFriendlyName = bIsDot ? LOCTEXT( "ArrayPinA_FriendlyName", "A" ) : LOCTEXT( "ArrayPin_FriendlyName", "Array" );
+
+	if (bIsDot)
+	{
+		const auto OtherArrayPin = CreatePin( EGPD_Input, CoreTechK2Utilities::GetWildcardArrayType( ), OtherArrayPinName );
+		OtherArrayPin->PinFriendlyName = LOCTEXT( "ArrayPinB_FriendlyName", "B" );
+	}
+
+	const auto ResultPin = CreatePin( EGPD_Output, UEdGraphSchema_K2::PC_Wildcard, ResultPinName );
+	ResultPin->PinFriendlyName = LOCTEXT( "ResultPin_FriendlyName", "Result" );
+
+	SetArrayType( CoreTechK2Utilities::GetWildcardArrayType( ) );
+}
+
+void UK2Node_ArrayReduce::ReallocatePinsDuringReconstruction( TArray< UEdGraphPin* > &OldPins )
+{
+	Super::ReallocatePinsDuringReconstruction( OldPins );
+
+	if (const auto OldArrayType = CoreTechK2Utilities::GetReconstructedPinType( OldPins, ArrayPinName ))
+		SetArrayType( *OldArrayType );
+}
+
+void UK2Node_ArrayReduce::PostPasteNode( )
+{
+	Super::PostPasteNode( );
+
+	const auto OtherArrayPin = GetOtherArrayPin( );
+	if (CoreTechK2Utilities::IsPinTypeStale( GetArrayPin( ) ) || ((OtherArrayPin != nullptr) && CoreTechK2Utilities::IsPinTypeStale( OtherArrayPin )))
+		PinConnectionListChanged( GetArrayPin( ) );
+}
+
+void UK2Node_ArrayReduce::SetArrayType( const FEdGraphPinType &ArrayType )
+{
+	const auto ArrayPin = GetArrayPin( );
+	ArrayPin->PinType = ArrayType;
+	CoreTechK2Utilities::SetPinToolTip( ArrayPin, LOCTEXT( "ArrayPin_Tooltip", "Array of numbers to reduce" ) );
+
+	if (const auto OtherArrayPin = GetOtherArrayPin( ))
+	{
+		OtherArrayPin->PinType = ArrayType;
+		CoreTechK2Utilities::SetPinToolTip( OtherArrayPin, LOCTEXT( "ArrayPin_Tooltip", "Array of numbers to reduce" ) );
+	}
+
+	const auto ResultPin = GetResultPin( );
+	ResultPin->PinType = ArrayType;
+	ResultPin->PinType.ContainerType = EPinContainerType::None;
+	ResultPin->PinType.bIsConst = false;
+	ResultPin->PinType.bIsReference = false;
+
+	// Averages are always fractional, regardless of the element type
+	if ((Reduction == ECoreTechArrayReduction::Average) && (ArrayType.PinCategory != UEdGraphSchema_K2::PC_Wildcard))
+	{
+		ResultPin->PinType.PinCategory = UEdGraphSchema_K2::PC_Real;
+		ResultPin->PinType.PinSubCategory = UEdGraphSchema_K2::PC_Double;
+	}
+
+	CoreTechK2Utilities::SetPinToolTip( ResultPin, LOCTEXT( "ResultPin_Tooltip", "Reduction of all the array elements" ) );
+}
+
+UFunction* UK2Node_ArrayReduce::GetReductionFunction( const FEdGraphPinType &ElementType ) const
+{
+	const auto TypeIndex = GetNumericTypeIndex( ElementType );
+	if (TypeIndex == INDEX_NONE)
+		return nullptr;
+
+	static const FName FunctionNames[ ][ 3 ] =
+	{
+		{ GET_FUNCTION_NAME_CHECKED( UCoreTechArrayLibrary, Array_SumInt ), GET_FUNCTION_NAME_CHECKED( UCoreTechArrayLibrary, Array_SumFloat ), GET_FUNCTION_NAME_CHECKED( UCoreTechArrayLibrary, Array_SumDouble ) },
+		{ GET_FUNCTION_NAME_CHECKED( UCoreTechArrayLibrary, Array_MinInt ), GET_FUNCTION_NAME_CHECKED( UCoreTechArrayLibrary, Array_MinFloat ), GET_FUNCTION_NAME_CHECKED( UCoreTechArrayLibrary, Array_MinDouble ) },
+		{ GET_FUNCTION_NAME_CHECKED( UCoreTechArrayLibrary, Array_MaxInt ), GET_FUNCTION_NAME_CHECKED( UCoreTechArrayLibrary, Array_MaxFloat ), GET_FUNCTION_NAME_CHECKED( UCoreTechArrayLibrary, Array_MaxDouble ) },
+		{ GET_FUNCTION_NAME_CHECKED( UCoreTechArrayLibrary, Array_AverageInt ), GET_FUNCTION_NAME_CHECKED( UCoreTechArrayLibrary, Array_AverageFloat ), GET_FUNCTION_NAME_CHECKED( UCoreTechArrayLibrary, Array_AverageDouble ) },
+		{ GET_FUNCTION_NAME_CHECKED( UCoreTechArrayLibrary, Array_DotInt ), GET_FUNCTION_NAME_CHECKED( UCoreTechArrayLibrary, Array_DotFloat ), GET_FUNCTION_NAME_CHECKED( UCoreTechArrayLibrary, Array_DotDouble ) },
+	};
+
+	return UCoreTechArrayLibrary::StaticClass( )->FindFunctionByName( FunctionNames[ (int)Reduction ][ TypeIndex ] );
+}
+
+void UK2Node_ArrayReduce::ExpandNode( FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph )
+{
+	Super::ExpandNode( CompilerContext, SourceGraph );
+
+	if (CheckForErrors( CompilerContext ))
+	{
+		// remove all the links to this node as they are no longer needed
+		BreakAllNodeLinks( );
+		return;
+	}
+
+	const auto ArrayPin = GetArrayPin( );
+	const auto OtherArrayPin = GetOtherArrayPin( );
+	const auto ResultPin = GetResultPin( );
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// Call the native kernel for the element type, no loop required
+	const auto CallReduce = CompilerContext.SpawnIntermediateNode< UK2Node_CallFunction >( this, SourceGraph );
+	CallReduce->SetFromFunction( GetReductionFunction( ArrayPin->PinType ) );
+	CallReduce->AllocateDefaultPins( );
+
+	if (OtherArrayPin != nullptr)
+	{
+		CompilerContext.MovePinLinksToIntermediate( *ArrayPin, *CallReduce->FindPinChecked( TEXT( "A" ) ) );
+		CompilerContext.MovePinLinksToIntermediate( *OtherArrayPin, *CallReduce->FindPinChecked( TEXT( "B" ) ) );
+	}
+	else
+	{
+		CompilerContext.MovePinLinksToIntermediate( *ArrayPin, *CallReduce->FindPinChecked( TEXT( "TargetArray" ) ) );
+	}
+
+	CompilerContext.MovePinLinksToIntermediate( *ResultPin, *CallReduce->GetReturnValuePin( ) );
+
+	///////////////////////////////////////////////////////////////////////////////////
+	//
+	BreakAllNodeLinks( );
+}
+
+bool UK2Node_ArrayReduce::CheckForErrors( const FKismetCompilerContext& CompilerContext )
+{
+	bool bError = false;
+
+	const auto ArrayPin = GetArrayPin( );
+	const auto OtherArrayPin = GetOtherArrayPin( );
+
+	if ((ArrayPin->LinkedTo.Num( ) == 0) || ((OtherArrayPin != nullptr) && (OtherArrayPin->LinkedTo.Num( ) == 0)))
+	{
+		CompilerContext.MessageLog.Error( *LOCTEXT( "MissingArray_Error", "Array reduction node @@ must have an array to reduce." ).ToString( ), this );
+		bError = true;
+	}
+	else if (GetReductionFunction( ArrayPin->PinType ) == nullptr)
+	{
+		CompilerContext.MessageLog.Error( *LOCTEXT( "InvalidType_Error", "Array reduction node @@ can only reduce arrays of integers, floats or doubles." ).ToString( ), this );
+		bError = true;
+	}
+	else if ((OtherArrayPin != nullptr) && (GetNumericTypeIndex( OtherArrayPin->LinkedTo[ 0 ]->PinType ) != GetNumericTypeIndex( ArrayPin->PinType )))
+	{
+		CompilerContext.MessageLog.Error( *LOCTEXT( "MismatchedTypes_Error", "Array reduction node @@ must have two arrays with the same type of element." ).ToString( ), this );
+		bError = true;
+	}
+
+	return bError;
+}
+
+bool UK2Node_ArrayReduce::IsConnectionDisallowed( const UEdGraphPin* MyPin, const UEdGraphPin* OtherPin, FString& OutReason ) const
+{
+	if ((MyPin->PinName == ArrayPinName) || (MyPin->PinName == OtherArrayPinName))
+	{
+		if ((OtherPin->PinType.PinCategory != UEdGraphSchema_K2::PC_Wildcard) && (GetNumericTypeIndex( OtherPin->PinType ) == INDEX_NONE))
+		{
+			OutReason = LOCTEXT( "InvalidType_Reason", "Only arrays of integers, floats or doubles can be reduced." ).ToString( );
+			return true;
+		}
+
+		// Once either of the arrays has set the type, the other has to match it
+		const auto TypedPin = (MyPin->PinName == ArrayPinName) ? GetOtherArrayPin( ) : GetArrayPin( );
+		if ((TypedPin != nullptr) && (TypedPin->LinkedTo.Num( ) > 0) && (OtherPin->PinType.PinCategory != UEdGraphSchema_K2::PC_Wildcard) &&
+			(GetNumericTypeIndex( OtherPin->PinType ) != GetNumericTypeIndex( TypedPin->PinType )))
+		{
+			OutReason = LOCTEXT( "MismatchedTypes_Reason", "Both arrays must have the same type of element." ).ToString( );
+			return true;
+		}
+	}
+	else if (MyPin->PinName == ResultPinName)
+	{
+		if (GetArrayPin( )->PinType.PinCategory == UEdGraphSchema_K2::PC_Wildcard)
+		{
+			OutReason = LOCTEXT( "NoArray_Reason", "Connect the array to reduce before using the result." ).ToString( );
+			return true;
+		}
+	}
+
+	return Super::IsConnectionDisallowed( MyPin, OtherPin, OutReason );
+}
+
+void UK2Node_ArrayReduce::PinConnectionListChanged( UEdGraphPin* Pin )
+{
+	Super::PinConnectionListChanged( Pin );
+
+	if (Pin == nullptr)
+		return;
+
+	if ((Pin->PinName == ArrayPinName) || (Pin->PinName == OtherArrayPinName))
+	{
+		// Either of the arrays can determine the type for the whole node
+		const auto ArrayPin = GetArrayPin( );
+		const auto OtherArrayPin = GetOtherArrayPin( );
+
+		if (ArrayPin->LinkedTo.Num( ) > 0)
+			SetArrayType( ArrayPin->LinkedTo[ 0 ]->PinType );
+		else if ((OtherArrayPin != nullptr) && (OtherArrayPin->LinkedTo.Num( ) > 0))
+			SetArrayType( OtherArrayPin->LinkedTo[ 0 ]->PinType );
+		else
+			SetArrayType( CoreTechK2Utilities::GetWildcardArrayType( ) );
+
+		CoreTechK2Utilities::RefreshAllowedConnections( this, GetResultPin( ) );
+	}
+}
+
+UEdGraphPin* UK2Node_ArrayReduce::GetArrayPin( void ) const
+{
+	return FindPinChecked( ArrayPinName );
+}
+
+UEdGraphPin* UK2Node_ArrayReduce::GetOtherArrayPin( void ) const
+{
+	return FindPin( OtherArrayPinName );
+}
+
+UEdGraphPin* UK2Node_ArrayReduce::GetResultPin( void ) const
+{
+	return FindPinChecked( ResultPinName );
+}
+
+FText UK2Node_ArrayReduce::GetNodeTitle( ENodeTitleType::Type TitleType ) const
+{
+	const auto ReductionName = StaticEnum< ECoreTechArrayReduction >( )->GetDisplayNameTextByValue( (int64)Reduction );
+	return FText::Format( LOCTEXT( "NodeTitle", "Array {0} (Native)" ), ReductionName );
+}
+
+FText UK2Node_ArrayReduce::GetTooltipText( ) const
+{
+	switch (Reduction)
+	{
+		case ECoreTechArrayReduction::Sum:
+			return LOCTEXT( "NodeToolTip_Sum", "Add together all the elements of an array. Integer sums wrap around on overflow." );
+		case ECoreTechArrayReduction::Min:
+			return LOCTEXT( "NodeToolTip_Min", "Find the smallest element of an array (zero if the array is empty)" );
+		case ECoreTechArrayReduction::Max:
+			return LOCTEXT( "NodeToolTip_Max", "Find the largest element of an array (zero if the array is empty)" );
+		case ECoreTechArrayReduction::Average:
+			return LOCTEXT( "NodeToolTip_Average", "Find the mean of all the elements of an array (zero if the array is empty)" );
+		case ECoreTechArrayReduction::Dot:
+			return LOCTEXT( "NodeToolTip_Dot", "Sum the products of the matching elements of two arrays. Integer sums wrap around on overflow." );
+	}
+
+	return FText::GetEmpty( );
+}
+
+FText UK2Node_ArrayReduce::GetMenuCategory( ) const
+{
+	return LOCTEXT( "NodeMenu", "Core Utilities" );
+}
+
+FSlateIcon UK2Node_ArrayReduce::GetIconAndTint( FLinearColor& OutColor ) const
+{
+	return CoreTechK2Utilities::GetPureFunctionIconAndTint( OutColor );
+}
+
+void UK2Node_ArrayReduce::GetMenuActions( FBlueprintActionDatabaseRegistrar& ActionRegistrar ) const
+{
+	CoreTechK2Utilities::EnumGetMenuActions( this, ActionRegistrar, StaticEnum< ECoreTechArrayReduction >( ), []( UEdGraphNode *NewNode, int64 Value )
+	{
+		CastChecked< UK2Node_ArrayReduce >( NewNode )->Reduction = (ECoreTechArrayReduction)Value;
+	} );
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,65 @@
+
+#pragma once
+
+#include "K2Node.h"
+
+#include "K2Node_ArrayReduce.generated.h"
+
+// The reductions that can be done by the array reduce node
+UENUM( )
+enum class ECoreTechArrayReduction : uint8
+{
+	Sum,
+	Min,
+	Max,
+	Average,
+	Dot,
+};
+
+UCLASS( )
+class CORETECHDEVELOPER_API UK2Node_ArrayReduce : public UK2Node
+{
+	GENERATED_BODY( )
+public:
+
+	// Pin Accessors
+	UE_NODISCARD UEdGraphPin* GetArrayPin( void ) const;
+	UE_NODISCARD UEdGraphPin* GetOtherArrayPin( void ) const;
+	UE_NODISCARD UEdGraphPin* GetResultPin( void ) const;
+
+	// K2Node API
+	UE_NODISCARD bool IsNodePure( ) const override { return true; }
+	UE_NODISCARD bool IsNodeSafeToIgnore( ) const override { return true; }
+	void GetMenuActions( FBlueprintActionDatabaseRegistrar& ActionRegistrar ) const override;
+	UE_NODISCARD FText GetMenuCategory( ) const override;
+	UE_NODISCARD bool IsConnectionDisallowed( const UEdGraphPin* MyPin, const UEdGraphPin* OtherPin, FString& OutReason ) const override;
+
+	// EdGraphNode API
+	void AllocateDefaultPins( ) override;
+	void ExpandNode( FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph ) override;
+	UE_NODISCARD FText GetNodeTitle( ENodeTitleType::Type TitleType ) const override;
+	UE_NODISCARD FText GetTooltipText( ) const override;
+	UE_NODISCARD FSlateIcon GetIconAndTint( FLinearColor& OutColor ) const override;
+	void PinConnectionListChanged( UEdGraphPin* Pin ) override;
+	void PostPasteNode( ) override;
+	void ReallocatePinsDuringReconstruction( TArray< UEdGraphPin* > &OldPins ) override;
+
+private:
+	// Pin Names
+	static const FName ArrayPinName;
+	static const FName OtherArrayPinName;
+	static const FName ResultPinName;
+
+	// Determine if there is any configuration options that shouldn't be allowed
+	UE_NODISCARD bool CheckForErrors( const FKismetCompilerContext& CompilerContext );
+
+	// Update the types of all the pins to match the array type
+	void SetArrayType( const FEdGraphPinType &ArrayType );
+
+	// Find the native function that implements the reduction for a specific element type
+	UE_NODISCARD UFunction* GetReductionFunction( const FEdGraphPinType &ElementType ) const;
+
+	// Which reduction this node performs
+	UPROPERTY( )
+	ECoreTechArrayReduction Reduction = ECoreTechArrayReduction::Sum;
+};
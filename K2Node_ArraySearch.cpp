@@ -0,0 +1,401 @@
+
+#include "K2Nodes/K2Node_ArraySearch.h"
+
+#include "CoreTechArrayLibrary.h"
+#include "CoreTechK2Utilities.h"
+
+// BlueprintGraph
+#include "K2Node_CallFunction.h"
+#include "K2Node_Self.h"
+
+// KismetCompiler
+#include "KismetCompiler.h"
+
+// UnrealEd
+#include "Kismet2/BlueprintEditorUtils.h"
+
+#define LOCTEXT_NAMESPACE "K2Node_ArraySearch"
+
+const FName UK2Node_ArraySearch::ArrayPinName( TEXT( "ArrayPin" ) );
+const FName UK2Node_ArraySearch::TargetPinName( TEXT( "TargetPin" ) );
+const FName UK2Node_ArraySearch::ResultPinName( TEXT( "ResultPin" ) );
+const FName UK2Node_ArraySearch::ElementPinName( TEXT( "ElementPin" ) );
+const FName UK2Node_ArraySearch::IndexPinName( TEXT( "IndexPin" ) );
+
+void UK2Node_ArraySearch::AllocateDefaultPins( )
+{
+	Super::AllocateDefaultPins( );
+
+	const auto ArrayPin = CreatePin( EGPD_Input, CoreTechK2Utilities::GetWildcardArrayType( ), ArrayPinName );
+	ArrayPin->PinFriendlyName = LOCTEXT( "ArrayPin_FriendlyName", "Array" );
+
+	// Static predicates don't need anything to be called on
+	const auto TargetPin = CreatePin( EGPD_Input, UEdGraphSchema_K2::PC_Object, UObject::StaticClass( ), TargetPinName );
+	TargetPin->PinFriendlyName = LOCTEXT( "TargetPin_FriendlyName", "Target" );
+	TargetPin->PinToolTip = LOCTEXT( "TargetPin_Tooltip", "Object to call the predicate on, self when not connected" ).ToString( );
+	TargetPin->bDefaultValueIsIgnored = true;
+	TargetPin->bHidden = (PredicateClass != nullptr);
+
+	switch (Search)
+	{
+		case ECoreTechArraySearch::FindFirst:
+		{
+			const auto FoundPin = CreatePin( EGPD_Output, UEdGraphSchema_K2::PC_Boolean, ResultPinName );
+			FoundPin->PinFriendlyName = LOCTEXT( "FoundPin_FriendlyName", "Found" );
+			FoundPin->PinToolTip = LOCTEXT( "FoundPin_Tooltip", "Whether any element matched the predicate" ).ToString( );
+
+			const auto ElementPin = CreatePin( EGPD_Output, UEdGraphSchema_K2::PC_Wildcard, ElementPinName );
+			ElementPin->PinFriendlyName = LOCTEXT( "ElementPin_FriendlyName", "Element" );
+
+			const auto IndexPin = CreatePin( EGPD_Output, UEdGraphSchema_K2::PC_Int, IndexPinName );
+			IndexPin->PinFriendlyName = LOCTEXT( "IndexPin_FriendlyName", "Index" );
+			IndexPin->PinToolTip = LOCTEXT( "IndexPin_Tooltip", "Index of the first matching element, -1 if nothing matched" ).ToString( );
+			break;
+		}
+
+		case ECoreTechArraySearch::Any:
+		case ECoreTechArraySearch::All:
+		{
+			const auto ResultPin = CreatePin( EGPD_Output, UEdGraphSchema_K2::PC_Boolean, ResultPinName );
+			ResultPin->PinFriendlyName = LOCTEXT( "ResultPin_FriendlyName", "Result" );
+			break;
+		}
+
+		case ECoreTechArraySearch::Count:
+		{
+			const auto CountPin = CreatePin( EGPD_Output, UEdGraphSchema_K2::PC_Int, ResultPinName );
+			CountPin->PinFriendlyName = LOCTEXT( "CountPin_FriendlyName", "Count" );
+			CountPin->PinToolTip = LOCTEXT( "CountPin_Tooltip", "Number of elements that matched the predicate" ).ToString( );
+			break;
+		}
+	}
+
+	SetArrayType( CoreTechK2Utilities::GetWildcardArrayType( ) );
+}
+
+void UK2Node_ArraySearch::ReallocatePinsDuringReconstruction( TArray< UEdGraphPin* > &OldPins )
+{
+	Super::ReallocatePinsDuringReconstruction( OldPins );
+
+	if (const auto OldArrayType = CoreTechK2Utilities::GetReconstructedPinType( OldPins, ArrayPinName ))
+		SetArrayType( *OldArrayType );
+}
+
+void UK2Node_ArraySearch::PostPasteNode( )
+{
+	Super::PostPasteNode( );
+
+	if (CoreTechK2Utilities::IsPinTypeStale( GetArrayPin( ) ))
+		PinConnectionListChanged( GetArrayPin( ) );
+}
+
+#if WITH_EDITOR
+void UK2Node_ArraySearch::PostEditChangeProperty( FPropertyChangedEvent &PropertyChangedEvent )
+{
+	Super::PostEditChangeProperty( PropertyChangedEvent );
+
+	bool bRefresh = false;
+
+	if (PropertyChangedEvent.GetPropertyName( ) == GET_MEMBER_NAME_CHECKED( UK2Node_ArraySearch, PredicateClass ))
+	{
+		const auto TargetPin = GetTargetPin( );
+		TargetPin->bHidden = (PredicateClass != nullptr);
+		if (TargetPin->bHidden)
+			TargetPin->BreakAllPinLinks( true );
+
+		bRefresh = true;
+	}
+	else if (PropertyChangedEvent.GetPropertyName( ) == GET_MEMBER_NAME_CHECKED( UK2Node_ArraySearch, PredicateName ))
+	{
+		bRefresh = true;
+	}
+
+	if (bRefresh)
+	{
+		// Poke the graph to update the visuals based on the above changes
+		GetGraph( )->NotifyGraphChanged( );
+		FBlueprintEditorUtils::MarkBlueprintAsModified( GetBlueprint( ) );
+	}
+}
+#endif
+
+void UK2Node_ArraySearch::SetArrayType( const FEdGraphPinType &ArrayType )
+{
+	const auto ArrayPin = GetArrayPin( );
+	ArrayPin->PinType = ArrayType;
+	CoreTechK2Utilities::SetPinToolTip( ArrayPin, LOCTEXT( "ArrayPin_Tooltip", "Array to search" ) );
+
+	if (const auto ElementPin = GetElementPin( ))
+	{
+		ElementPin->PinType = ArrayType;
+		ElementPin->PinType.ContainerType = EPinContainerType::None;
+		ElementPin->PinType.bIsConst = false;
+		ElementPin->PinType.bIsReference = false;
+		CoreTechK2Utilities::SetPinToolTip( ElementPin, LOCTEXT( "ElementPin_Tooltip", "Copy of the first matching element" ) );
+	}
+}
+
+UFunction* UK2Node_ArraySearch::FindPredicate( ) const
+{
+	if (PredicateName.IsNone( ))
+		return nullptr;
+
+	const UClass *Class = PredicateClass;
+	if (Class == nullptr)
+	{
+		const auto TargetPin = GetTargetPin( );
+		if (TargetPin->LinkedTo.Num( ) > 0)
+		{
+			const auto &TargetType = TargetPin->LinkedTo[ 0 ]->PinType;
+			if (TargetType.PinSubCategory == UEdGraphSchema_K2::PSC_Self)
+				Class = GetBlueprintClassFromNode( );
+			else
+				Class = Cast< UClass >( TargetType.PinSubCategoryObject.Get( ) );
+		}
+		else
+		{
+			Class = GetBlueprintClassFromNode( );
+		}
+	}
+
+	return (Class != nullptr) ? Class->FindFunctionByName( PredicateName ) : nullptr;
+}
+
+void UK2Node_ArraySearch::ExpandNode( FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph )
+{
+	Super::ExpandNode( CompilerContext, SourceGraph );
+
+	if (CheckForErrors( CompilerContext ))
+	{
+		// remove all the links to this node as they are no longer needed
+		BreakAllNodeLinks( );
+		return;
+	}
+
+	const auto ArrayPin = GetArrayPin( );
+	const auto TargetPin = GetTargetPin( );
+	const auto ResultPin = GetResultPin( );
+
+	static const FName FunctionNames[ ] =
+	{
+		GET_FUNCTION_NAME_CHECKED( UCoreTechArrayLibrary, Array_FindFirstMatch ),
+		GET_FUNCTION_NAME_CHECKED( UCoreTechArrayLibrary, Array_AnyMatch ),
+		GET_FUNCTION_NAME_CHECKED( UCoreTechArrayLibrary, Array_AllMatch ),
+		GET_FUNCTION_NAME_CHECKED( UCoreTechArrayLibrary, Array_CountMatches ),
+	};
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// Call the native scan, which can stop as soon as the answer is known
+	const auto CallSearch = CompilerContext.SpawnIntermediateNode< UK2Node_CallFunction >( this, SourceGraph );
+	CallSearch->FunctionReference.SetExternalMember( FunctionNames[ (int)Search ], UCoreTechArrayLibrary::StaticClass( ) );
+	CallSearch->AllocateDefaultPins( );
+
+	const auto Search_Array = CallSearch->FindPinChecked( TEXT( "TargetArray" ) );
+	const auto Search_Target = CallSearch->FindPinChecked( TEXT( "Target" ) );
+	const auto Search_PredicateName = CallSearch->FindPinChecked( TEXT( "PredicateName" ) );
+	const auto Search_Return = CallSearch->GetReturnValuePin( );
+
+	// Coerce the wildcard pin types
+	Search_Array->PinType = ArrayPin->PinType;
+
+	CompilerContext.MovePinLinksToIntermediate( *ArrayPin, *Search_Array );
+	Search_PredicateName->DefaultValue = PredicateName.ToString( );
+	CompilerContext.MovePinLinksToIntermediate( *ResultPin, *Search_Return );
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// Figure out what the predicate is called on
+	if (PredicateClass != nullptr)
+	{
+		Search_Target->DefaultObject = PredicateClass->GetDefaultObject( );
+	}
+	else if (TargetPin->LinkedTo.Num( ) > 0)
+	{
+		CompilerContext.MovePinLinksToIntermediate( *TargetPin, *Search_Target );
+	}
+	else
+	{
+		const auto SelfNode = CompilerContext.SpawnIntermediateNode< UK2Node_Self >( this, SourceGraph );
+		SelfNode->AllocateDefaultPins( );
+
+		SelfNode->FindPinChecked( UEdGraphSchema_K2::PN_Self )->MakeLinkTo( Search_Target );
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// Only finding returns the element that was found
+	if (Search == ECoreTechArraySearch::FindFirst)
+	{
+		const auto ElementPin = GetElementPin( );
+		const auto Search_Item = CallSearch->FindPinChecked( TEXT( "Item" ) );
+
+		// Coerce the wildcard pin types
+		Search_Item->PinType = ElementPin->PinType;
+
+		CompilerContext.MovePinLinksToIntermediate( *ElementPin, *Search_Item );
+		CompilerContext.MovePinLinksToIntermediate( *GetIndexPin( ), *CallSearch->FindPinChecked( TEXT( "Index" ) ) );
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////
+	//
+	BreakAllNodeLinks( );
+}
+
+bool UK2Node_ArraySearch::CheckForErrors( const FKismetCompilerContext& CompilerContext )
+{
+	bool bError = false;
+
+	const auto ArrayPin = GetArrayPin( );
+	if (ArrayPin->LinkedTo.Num( ) == 0)
+	{
+		CompilerContext.MessageLog.Error( *LOCTEXT( "MissingArray_Error", "Array search node @@ must have an array to search." ).ToString( ), this );
+		return true;
+	}
+
+	const auto Predicate = FindPredicate( );
+	if (Predicate == nullptr)
+	{
+		CompilerContext.MessageLog.Error( *FText::Format( LOCTEXT( "MissingPredicate_Error", "Array search node @@ can't find the predicate function '{0}'." ), FText::FromName( PredicateName ) ).ToString( ), this );
+		return true;
+	}
+
+	if (!Predicate->HasAnyFunctionFlags( FUNC_BlueprintPure ) && !FBlueprintEditorUtils::HasFunctionBlueprintThreadSafeMetaData( Predicate ))
+	{
+		CompilerContext.MessageLog.Error( *LOCTEXT( "ImpurePredicate_Error", "Array search node @@ can only use pure or thread safe predicate functions." ).ToString( ), this );
+		bError = true;
+	}
+
+	if ((PredicateClass != nullptr) && !Predicate->HasAnyFunctionFlags( FUNC_Static ))
+	{
+		CompilerContext.MessageLog.Error( *LOCTEXT( "NonStaticPredicate_Error", "Array search node @@ needs a static predicate function when a predicate class is set." ).ToString( ), this );
+		bError = true;
+	}
+
+	// The predicate has to take exactly one element and return a bool, besides the world context of Blueprint function libraries
+	FProperty *ElementParam = nullptr;
+	FProperty *ReturnParam = nullptr;
+	FObjectPropertyBase *WorldContextParam = nullptr;
+	const bool bValidParams = UCoreTechArrayLibrary::FindPredicateParams( Predicate, ElementParam, ReturnParam, WorldContextParam );
+
+	const auto K2Schema = CompilerContext.GetSchema( );
+
+	FEdGraphPinType ElementType = ArrayPin->PinType;
+	ElementType.ContainerType = EPinContainerType::None;
+
+	// Elements are passed to the predicate without any conversion, so floats and doubles can't be mixed
+	FEdGraphPinType ParamType;
+	const bool bValidSignature = bValidParams && (CastField< FBoolProperty >( ReturnParam ) != nullptr) &&
+		K2Schema->ConvertPropertyToPinType( ElementParam, ParamType ) && K2Schema->ArePinTypesCompatible( ElementType, ParamType ) &&
+		((ParamType.PinCategory != UEdGraphSchema_K2::PC_Real) || (ElementType.PinSubCategory == ParamType.PinSubCategory));
+
+	if (!bValidSignature)
+	{
+		CompilerContext.MessageLog.Error( *FText::Format( LOCTEXT( "InvalidPredicate_Error", "Array search node @@ needs '{0}' to take a single array element and return a bool." ), FText::FromName( PredicateName ) ).ToString( ), this );
+		bError = true;
+	}
+
+	return bError;
+}
+
+bool UK2Node_ArraySearch::IsConnectionDisallowed( const UEdGraphPin* MyPin, const UEdGraphPin* OtherPin, FString& OutReason ) const
+{
+	if (MyPin->PinName == ElementPinName)
+	{
+		if (GetArrayPin( )->PinType.PinCategory == UEdGraphSchema_K2::PC_Wildcard)
+		{
+			OutReason = LOCTEXT( "NoArray_Reason", "Connect the array to search before using the element." ).ToString( );
+			return true;
+		}
+	}
+
+	return Super::IsConnectionDisallowed( MyPin, OtherPin, OutReason );
+}
+
+void UK2Node_ArraySearch::PinConnectionListChanged( UEdGraphPin* Pin )
+{
+	Super::PinConnectionListChanged( Pin );
+
+	if (Pin == nullptr)
+		return;
+
+	if (Pin->PinName == ArrayPinName)
+	{
+		if (Pin->LinkedTo.Num( ) > 0)
+			SetArrayType( Pin->LinkedTo[ 0 ]->PinType );
+		else
+			SetArrayType( CoreTechK2Utilities::GetWildcardArrayType( ) );
+
+		if (const auto ElementPin = GetElementPin( ))
+			CoreTechK2Utilities::RefreshAllowedConnections( this, ElementPin );
+	}
+}
+
+UEdGraphPin* UK2Node_ArraySearch::GetArrayPin( void ) const
+{
+	return FindPinChecked( ArrayPinName );
+}
+
+UEdGraphPin* UK2Node_ArraySearch::GetTargetPin( void ) const
+{
+	return FindPinChecked( TargetPinName );
+}
+
+UEdGraphPin* UK2Node_ArraySearch::GetResultPin( void ) const
+{
+	return FindPinChecked( ResultPinName );
+}
+
+UEdGraphPin* UK2Node_ArraySearch::GetElementPin( void ) const
+{
+	return FindPin( ElementPinName );
+}
+
+UEdGraphPin* UK2Node_ArraySearch::GetIndexPin( void ) const
+{
+	return FindPin( IndexPinName );
+}
+
+FText UK2Node_ArraySearch::GetNodeTitle( ENodeTitleType::Type TitleType ) const
+{
+	const auto SearchName = StaticEnum< ECoreTechArraySearch >( )->GetDisplayNameTextByValue( (int64)Search );
+
+	if ((TitleType == ENodeTitleType::FullTitle) && !PredicateName.IsNone( ))
+		return FText::Format( LOCTEXT( "NodeTitle_Predicate", "Array {0} (Native)\n{1}" ), SearchName, FText::FromName( PredicateName ) );
+
+	return FText::Format( LOCTEXT( "NodeTitle", "Array {0} (Native)" ), SearchName );
+}
+
+FText UK2Node_ArraySearch::GetTooltipText( ) const
+{
+	switch (Search)
+	{
+		case ECoreTechArraySearch::FindFirst:
+			return LOCTEXT( "NodeToolTip_FindFirst", "Find the first element of an array that the predicate function returns true for" );
+		case ECoreTechArraySearch::Any:
+			return LOCTEXT( "NodeToolTip_Any", "Whether the predicate function returns true for any element of an array" );
+		case ECoreTechArraySearch::All:
+			return LOCTEXT( "NodeToolTip_All", "Whether the predicate function returns true for every element of an array (true if the array is empty)" );
+		case ECoreTechArraySearch::Count:
+			return LOCTEXT( "NodeToolTip_Count", "Count the elements of an array that the predicate function returns true for" );
+	}
+
+	return FText::GetEmpty( );
+}
+
+FText UK2Node_ArraySearch::GetMenuCategory( ) const
+{
+	return LOCTEXT( "NodeMenu", "Core Utilities" );
+}
+
+FSlateIcon UK2Node_ArraySearch::GetIconAndTint( FLinearColor& OutColor ) const
+{
+	return CoreTechK2Utilities::GetPureFunctionIconAndTint( OutColor );
+}
+
+void UK2Node_ArraySearch::GetMenuActions( FBlueprintActionDatabaseRegistrar& ActionRegistrar ) const
+{
+	CoreTechK2Utilities::EnumGetMenuActions( this, ActionRegistrar, StaticEnum< ECoreTechArraySearch >( ), []( UEdGraphNode *NewNode, int64 Value )
+	{
+		CastChecked< UK2Node_ArraySearch >( NewNode )->Search = (ECoreTechArraySearch)Value;
+	} );
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,82 @@
+
+#pragma once
+
+#include "K2Node.h"
+
+#include "K2Node_ArraySearch.generated.h"
+
+// The searches that can be done by the array search node
+UENUM( )
+enum class ECoreTechArraySearch : uint8
+{
+	FindFirst UMETA( DisplayName = "Find First Match" ),
+	Any UMETA( DisplayName = "Any Match" ),
+	All UMETA( DisplayName = "All Match" ),
+	Count UMETA( DisplayName = "Count Matches" ),
+};
+
+UCLASS( )
+class CORETECHDEVELOPER_API UK2Node_ArraySearch : public UK2Node
+{
+	GENERATED_BODY( )
+public:
+
+	// Pin Accessors
+	UE_NODISCARD UEdGraphPin* GetArrayPin( void ) const;
+	UE_NODISCARD UEdGraphPin* GetTargetPin( void ) const;
+	UE_NODISCARD UEdGraphPin* GetResultPin( void ) const;
+	UE_NODISCARD UEdGraphPin* GetElementPin( void ) const;
+	UE_NODISCARD UEdGraphPin* GetIndexPin( void ) const;
+
+	// K2Node API
+	UE_NODISCARD bool IsNodePure( ) const override { return true; }
+	UE_NODISCARD bool IsNodeSafeToIgnore( ) const override { return true; }
+	void GetMenuActions( FBlueprintActionDatabaseRegistrar& ActionRegistrar ) const override;
+	UE_NODISCARD FText GetMenuCategory( ) const override;
+	UE_NODISCARD bool IsConnectionDisallowed( const UEdGraphPin* MyPin, const UEdGraphPin* OtherPin, FString& OutReason ) const override;
+
+	// EdGraphNode API
+	void AllocateDefaultPins( ) override;
+	void ExpandNode( FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph ) override;
+	UE_NODISCARD FText GetNodeTitle( ENodeTitleType::Type TitleType ) const override;
+	UE_NODISCARD FText GetTooltipText( ) const override;
+	UE_NODISCARD FSlateIcon GetIconAndTint( FLinearColor& OutColor ) const override;
+	void PinConnectionListChanged( UEdGraphPin* Pin ) override;
+	bool ShouldShowNodeProperties( ) const override { return true; }
+	void PostPasteNode( ) override;
+	void ReallocatePinsDuringReconstruction( TArray< UEdGraphPin* > &OldPins ) override;
+
+	// Object API
+#if WITH_EDITOR
+	void PostEditChangeProperty( FPropertyChangedEvent &PropertyChangedEvent ) override;
+#endif
+
+private:
+	// Pin Names
+	static const FName ArrayPinName;
+	static const FName TargetPinName;
+	static const FName ResultPinName;
+	static const FName ElementPinName;
+	static const FName IndexPinName;
+
+	// Determine if there is any configuration options that shouldn't be allowed
+	UE_NODISCARD bool CheckForErrors( const FKismetCompilerContext& CompilerContext );
+
+	// Update the types of the array and element pins
+	void SetArrayType( const FEdGraphPinType &ArrayType );
+
+	// Find the function that will be called to test each element, if it exists
+	UE_NODISCARD UFunction* FindPredicate( ) const;
+
+	// Which search this node performs
+	UPROPERTY( )
+	ECoreTechArraySearch Search = ECoreTechArraySearch::FindFirst;
+
+	// The pure function that tests each element. It must take a single element and return a bool.
+	UPROPERTY( EditDefaultsOnly )
+	FName PredicateName;
+
+	// When set, the predicate is a static function of this class (like a thread safe function library) instead of a member function of the target
+	UPROPERTY( EditDefaultsOnly )
+	TSubclassOf< UObject > PredicateClass;
+};
@@ -0,0 +1,412 @@
+
+#include "K2Nodes/K2Node_AsyncLoadForEach.h"
+
+#include "CoreTechIterationLibrary.h"
+#include "CoreTechK2Utilities.h"
+
+// BlueprintGraph
+#include "K2Node_CallFunction.h"
+#include "K2Node_ExecutionSequence.h"
+#include "K2Node_IfThenElse.h"
+#include "K2Node_TemporaryVariable.h"
+
+// KismetCompiler
+#include "KismetCompiler.h"
+
+// UnrealEd
+#include "Kismet2/BlueprintEditorUtils.h"
+
+#define LOCTEXT_NAMESPACE "K2Node_AsyncLoadForEach"
+
+const FName UK2Node_AsyncLoadForEach::ArrayPinName( TEXT( "ArrayPin" ) );
+const FName UK2Node_AsyncLoadForEach::ChunkSizePinName( TEXT( "ChunkSizePin" ) );
+const FName UK2Node_AsyncLoadForEach::BreakPinName( TEXT( "BreakPin" ) );
+const FName UK2Node_AsyncLoadForEach::ElementPinName( TEXT( "ElementPin" ) );
+const FName UK2Node_AsyncLoadForEach::ArrayIndexPinName( TEXT( "ArrayIndexPin" ) );
+const FName UK2Node_AsyncLoadForEach::CompletedPinName( TEXT( "CompletedPin" ) );
+
+void UK2Node_AsyncLoadForEach::AllocateDefaultPins( )
+{
+	Super::AllocateDefaultPins( );
+
+	// Execution pin
+	CreatePin( EGPD_Input, UEdGraphSchema_K2::PC_Exec, UEdGraphSchema_K2::PN_Execute );
+
+	// Only needed when the Blueprint can't provide the world itself
+	const auto WorldContextPin = CreatePin( EGPD_Input, UEdGraphSchema_K2::PC_Object, UObject::StaticClass( ), CoreTechK2Utilities::PN_WorldContextObject );
+	const auto Blueprint = GetBlueprint( );
+	WorldContextPin->bHidden = (Blueprint == nullptr) || FBlueprintEditorUtils::ImplementsGetWorld( Blueprint );
+
+	const auto ArrayPin = CreatePin( EGPD_Input, CoreTechK2Utilities::GetWildcardArrayType( ), ArrayPinName );
+	ArrayPin->PinFriendlyName = LOCTEXT( "ArrayPin_FriendlyName", "Array" );
+
+	const auto ChunkSizePin = CreatePin( EGPD_Input, UEdGraphSchema_K2::PC_Int, ChunkSizePinName );
+	ChunkSizePin->PinFriendlyName = LOCTEXT( "ChunkSizePin_FriendlyName", "Chunk Size" );
+	ChunkSizePin->PinToolTip = LOCTEXT( "ChunkSizePin_Tooltip", "How many elements to request from the streamable manager at once, zero or less requests the whole array. The next chunk loads while the current one is visited, so up to two chunks are kept loaded." ).ToString( );
+	ChunkSizePin->DefaultValue = TEXT( "0" );
+	ChunkSizePin->bAdvancedView = true;
+
+	const auto BreakPin = CreatePin( EGPD_Input, UEdGraphSchema_K2::PC_Exec, BreakPinName );
+	BreakPin->PinFriendlyName = LOCTEXT( "BreakPin_FriendlyName", "Break" );
+	BreakPin->PinToolTip = LOCTEXT( "BreakPin_Tooltip", "Stop the loop, cancelling any loading that is still outstanding" ).ToString( );
+	BreakPin->bAdvancedView = true;
+
+	// For Each pin
+	const auto ForEachPin = CreatePin( EGPD_Output, UEdGraphSchema_K2::PC_Exec, UEdGraphSchema_K2::PN_Then );
+	ForEachPin->PinFriendlyName = LOCTEXT( "ForEachPin_FriendlyName", "Loop Body" );
+
+	const auto ElementPin = CreatePin( EGPD_Output, UEdGraphSchema_K2::PC_Wildcard, ElementPinName );
+	ElementPin->PinFriendlyName = LOCTEXT( "ElementPin_FriendlyName", "Array Element" );
+
+	const auto IndexPin = CreatePin( EGPD_Output, UEdGraphSchema_K2::PC_Int, ArrayIndexPinName );
+	IndexPin->PinFriendlyName = LOCTEXT( "IndexPin_FriendlyName", "Array Index" );
+	IndexPin->PinToolTip = LOCTEXT( "IndexPin_Tooltip", "Index of Element into Array" ).ToString( );
+
+	const auto CompletedPin = CreatePin( EGPD_Output, UEdGraphSchema_K2::PC_Exec, CompletedPinName );
+	CompletedPin->PinFriendlyName = LOCTEXT( "CompletedPin_FriendlyName", "Completed" );
+	CompletedPin->PinToolTip = LOCTEXT( "CompletedPin_Tooltip", "Execution once all array elements have been loaded and visited" ).ToString( );
+
+	CoreTechK2Utilities::SetPinToolTip( ArrayPin, LOCTEXT( "ArrayPin_Tooltip", "Array of soft references to load and visit all elements of" ) );
+	CoreTechK2Utilities::SetPinToolTip( ElementPin, LOCTEXT( "ElementPin_Tooltip", "Loaded element of the Array, null if it failed to load" ) );
+
+	if (AdvancedPinDisplay == ENodeAdvancedPins::NoPins)
+		AdvancedPinDisplay = ENodeAdvancedPins::Hidden;
+}
+
+void UK2Node_AsyncLoadForEach::ReallocatePinsDuringReconstruction( TArray< UEdGraphPin* > &OldPins )
+{
+	Super::ReallocatePinsDuringReconstruction( OldPins );
+
+	if (const auto OldArrayType = CoreTechK2Utilities::GetReconstructedPinType( OldPins, ArrayPinName ))
+		SetArrayType( *OldArrayType );
+}
+
+void UK2Node_AsyncLoadForEach::PostPasteNode( )
+{
+	Super::PostPasteNode( );
+
+	if (CoreTechK2Utilities::IsPinTypeStale( GetArrayPin( ) ))
+		PinConnectionListChanged( GetArrayPin( ) );
+}
+
+void UK2Node_AsyncLoadForEach::ExpandNode( FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph )
+{
+	Super::ExpandNode( CompilerContext, SourceGraph );
+
+	if (CheckForErrors( CompilerContext ))
+	{
+		// remove all the links to this node as they are no longer needed
+		BreakAllNodeLinks( );
+		return;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// Cache off versions of all our important pins
+	const auto ExecPin = GetExecPin( );
+	const auto WorldContextPin = GetWorldContextPin( );
+	const auto ArrayPin = GetArrayPin( );
+	const auto ChunkSizePin = GetChunkSizePin( );
+	const auto BreakPin = GetBreakPin( );
+
+	const auto ForEachPin = GetForEachPin( );
+	const auto ArrayElementPin = GetElementPin( );
+	const auto ArrayIndexPin = GetArrayIndexPin( );
+	const auto CompletedPin = GetCompletedPin( );
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// Create the cursor variable
+	const auto CreateTemporaryVariable = CompilerContext.SpawnIntermediateNode< UK2Node_TemporaryVariable >( this, SourceGraph );
+	CreateTemporaryVariable->VariableType.PinCategory = UEdGraphSchema_K2::PC_Struct;
+	CreateTemporaryVariable->VariableType.PinSubCategoryObject = FCoreTechSoftObjectCursor::StaticStruct( );
+	CreateTemporaryVariable->AllocateDefaultPins( );
+
+	const auto Temp_Variable = CreateTemporaryVariable->GetVariablePin( );
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// Point the cursor at the start of the array
+	const auto CallBegin = CompilerContext.SpawnIntermediateNode< UK2Node_CallFunction >( this, SourceGraph );
+	CallBegin->FunctionReference.SetExternalMember( GET_FUNCTION_NAME_CHECKED( UCoreTechIterationLibrary, SoftObjectCursor_Begin ), UCoreTechIterationLibrary::StaticClass( ) );
+	CallBegin->AllocateDefaultPins( );
+
+	const auto Begin_Exec = CallBegin->GetExecPin( );
+	const auto Begin_Cursor = CallBegin->FindPinChecked( TEXT( "Cursor" ) );
+	const auto Begin_Then = CallBegin->GetThenPin( );
+
+	CompilerContext.MovePinLinksToIntermediate( *ExecPin, *Begin_Exec );
+	Temp_Variable->MakeLinkTo( Begin_Cursor );
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// Request the next chunk as a single batch, finishing once there isn't one
+	const auto CallRequest = CompilerContext.SpawnIntermediateNode< UK2Node_CallFunction >( this, SourceGraph );
+	CallRequest->FunctionReference.SetExternalMember( GET_FUNCTION_NAME_CHECKED( UCoreTechIterationLibrary, SoftObjectCursor_RequestChunk ), UCoreTechIterationLibrary::StaticClass( ) );
+	CallRequest->AllocateDefaultPins( );
+
+	const auto Request_Exec = CallRequest->GetExecPin( );
+	const auto Request_Array = CallRequest->FindPinChecked( TEXT( "SoftObjects" ) );
+	const auto Request_ChunkSize = CallRequest->FindPinChecked( TEXT( "ChunkSize" ) );
+	const auto Request_Cursor = CallRequest->FindPinChecked( TEXT( "Cursor" ) );
+	const auto Request_Loaded = CallRequest->FindPinChecked( TEXT( "bLoaded" ) );
+	const auto Request_Return = CallRequest->GetReturnValuePin( );
+	const auto Request_Then = CallRequest->GetThenPin( );
+
+	// Coerce the array to the specific soft reference type
+	Request_Array->PinType = ArrayPin->PinType;
+
+	Begin_Then->MakeLinkTo( Request_Exec );
+	CompilerContext.CopyPinLinksToIntermediate( *ArrayPin, *Request_Array );
+	CoreTechK2Utilities::MovePinLinksOrCopyDefaults( CompilerContext, ChunkSizePin, Request_ChunkSize );
+	Temp_Variable->MakeLinkTo( Request_Cursor );
+
+	const auto BranchOnChunk = CompilerContext.SpawnIntermediateNode< UK2Node_IfThenElse >( this, SourceGraph );
+	BranchOnChunk->AllocateDefaultPins( );
+
+	const auto BranchChunk_Exec = BranchOnChunk->GetExecPin( );
+	const auto BranchChunk_Input = BranchOnChunk->GetConditionPin( );
+	const auto BranchChunk_Then = BranchOnChunk->GetThenPin( );
+	const auto BranchChunk_Else = BranchOnChunk->GetElsePin( );
+
+	Request_Then->MakeLinkTo( BranchChunk_Exec );
+	Request_Return->MakeLinkTo( BranchChunk_Input );
+	CompilerContext.MovePinLinksToIntermediate( *CompletedPin, *BranchChunk_Else );
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// Only go latent when the chunk isn't already in memory
+	const auto BranchOnLoaded = CompilerContext.SpawnIntermediateNode< UK2Node_IfThenElse >( this, SourceGraph );
+	BranchOnLoaded->AllocateDefaultPins( );
+
+	const auto BranchLoaded_Exec = BranchOnLoaded->GetExecPin( );
+	const auto BranchLoaded_Input = BranchOnLoaded->GetConditionPin( );
+	const auto BranchLoaded_Then = BranchOnLoaded->GetThenPin( );
+	const auto BranchLoaded_Else = BranchOnLoaded->GetElsePin( );
+
+	BranchChunk_Then->MakeLinkTo( BranchLoaded_Exec );
+	Request_Loaded->MakeLinkTo( BranchLoaded_Input );
+
+	const auto CallWait = CompilerContext.SpawnIntermediateNode< UK2Node_CallFunction >( this, SourceGraph );
+	CallWait->FunctionReference.SetExternalMember( GET_FUNCTION_NAME_CHECKED( UCoreTechIterationLibrary, SoftObjectCursor_WaitForChunk ), UCoreTechIterationLibrary::StaticClass( ) );
+	CallWait->AllocateDefaultPins( );
+
+	const auto Wait_Exec = CallWait->GetExecPin( );
+	const auto Wait_WorldContext = CallWait->FindPinChecked( TEXT( "WorldContextObject" ) );
+	const auto Wait_Cursor = CallWait->FindPinChecked( TEXT( "Cursor" ) );
+	const auto Wait_Then = CallWait->GetThenPin( );
+
+	BranchLoaded_Else->MakeLinkTo( Wait_Exec );
+	CompilerContext.MovePinLinksToIntermediate( *WorldContextPin, *Wait_WorldContext );
+	Temp_Variable->MakeLinkTo( Wait_Cursor );
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// Step through the loaded chunk, requesting the next chunk once it's been visited
+	const auto CallNext = CompilerContext.SpawnIntermediateNode< UK2Node_CallFunction >( this, SourceGraph );
+	CallNext->FunctionReference.SetExternalMember( GET_FUNCTION_NAME_CHECKED( UCoreTechIterationLibrary, SoftObjectCursor_Next ), UCoreTechIterationLibrary::StaticClass( ) );
+	CallNext->AllocateDefaultPins( );
+
+	const auto Next_Exec = CallNext->GetExecPin( );
+	const auto Next_Cursor = CallNext->FindPinChecked( TEXT( "Cursor" ) );
+	const auto Next_Index = CallNext->FindPinChecked( TEXT( "Index" ) );
+	const auto Next_Return = CallNext->GetReturnValuePin( );
+	const auto Next_Then = CallNext->GetThenPin( );
+
+	BranchLoaded_Then->MakeLinkTo( Next_Exec );
+	Wait_Then->MakeLinkTo( Next_Exec );
+	Temp_Variable->MakeLinkTo( Next_Cursor );
+	CompilerContext.MovePinLinksToIntermediate( *ArrayIndexPin, *Next_Index );
+
+	const auto BranchOnNext = CompilerContext.SpawnIntermediateNode< UK2Node_IfThenElse >( this, SourceGraph );
+	BranchOnNext->AllocateDefaultPins( );
+
+	const auto BranchNext_Exec = BranchOnNext->GetExecPin( );
+	const auto BranchNext_Input = BranchOnNext->GetConditionPin( );
+	const auto BranchNext_Then = BranchOnNext->GetThenPin( );
+	const auto BranchNext_Else = BranchOnNext->GetElsePin( );
+
+	Next_Then->MakeLinkTo( BranchNext_Exec );
+	Next_Return->MakeLinkTo( BranchNext_Input );
+	BranchNext_Else->MakeLinkTo( Request_Exec );
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// Sequence the loop body and stepping to the next element
+	const auto LoopSequence = CompilerContext.SpawnIntermediateNode< UK2Node_ExecutionSequence >( this, SourceGraph );
+	LoopSequence->AllocateDefaultPins( );
+
+	const auto Sequence_Exec = LoopSequence->GetExecPin( );
+	const auto Sequence_One = LoopSequence->GetThenPinGivenIndex( 0 );
+	const auto Sequence_Two = LoopSequence->GetThenPinGivenIndex( 1 );
+
+	BranchNext_Then->MakeLinkTo( Sequence_Exec );
+	CompilerContext.MovePinLinksToIntermediate( *ForEachPin, *Sequence_One );
+	Sequence_Two->MakeLinkTo( Next_Exec );
+
+	const auto GetArrayElement = CompilerContext.SpawnIntermediateNode< UK2Node_CallFunction >( this, SourceGraph );
+	GetArrayElement->FunctionReference.SetExternalMember( GET_FUNCTION_NAME_CHECKED( UCoreTechIterationLibrary, SoftObjectCursor_Get ), UCoreTechIterationLibrary::StaticClass( ) );
+	GetArrayElement->AllocateDefaultPins( );
+
+	const auto GetElement_Array = GetArrayElement->FindPinChecked( TEXT( "SoftObjects" ) );
+	const auto GetElement_Index = GetArrayElement->FindPinChecked( TEXT( "Index" ) );
+	const auto GetElement_Return = GetArrayElement->GetReturnValuePin( );
+
+	// Coerce the pin types to the specific object type
+	GetElement_Array->PinType = ArrayPin->PinType;
+	GetElement_Return->PinType = ArrayElementPin->PinType;
+
+	CompilerContext.CopyPinLinksToIntermediate( *ArrayPin, *GetElement_Array );
+	Next_Index->MakeLinkTo( GetElement_Index );
+	CompilerContext.MovePinLinksToIntermediate( *ArrayElementPin, *GetElement_Return );
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// Break cancels whatever is outstanding and exhausts the cursor. The loop will then fail to find
+	// another element or chunk on the next run of SequenceTwo and terminate.
+	const auto CallEnd = CompilerContext.SpawnIntermediateNode< UK2Node_CallFunction >( this, SourceGraph );
+	CallEnd->FunctionReference.SetExternalMember( GET_FUNCTION_NAME_CHECKED( UCoreTechIterationLibrary, SoftObjectCursor_End ), UCoreTechIterationLibrary::StaticClass( ) );
+	CallEnd->AllocateDefaultPins( );
+
+	const auto End_Exec = CallEnd->GetExecPin( );
+	const auto End_Cursor = CallEnd->FindPinChecked( TEXT( "Cursor" ) );
+
+	CompilerContext.MovePinLinksToIntermediate( *BreakPin, *End_Exec );
+	Temp_Variable->MakeLinkTo( End_Cursor );
+
+	///////////////////////////////////////////////////////////////////////////////////
+	//
+	BreakAllNodeLinks( );
+}
+
+bool UK2Node_AsyncLoadForEach::CheckForErrors( const FKismetCompilerContext& CompilerContext )
+{
+	bool bError = false;
+
+	if (GetArrayPin( )->LinkedTo.Num( ) == 0)
+	{
+		CompilerContext.MessageLog.Error( *LOCTEXT( "MissingArray_Error", "Async Load For Each node @@ must have an array to iterate." ).ToString( ), this );
+		bError = true;
+	}
+
+	return bError;
+}
+
+bool UK2Node_AsyncLoadForEach::IsConnectionDisallowed( const UEdGraphPin* MyPin, const UEdGraphPin* OtherPin, FString& OutReason ) const
+{
+	if (MyPin->PinName == ArrayPinName)
+	{
+		if ((OtherPin->PinType.PinCategory != UEdGraphSchema_K2::PC_Wildcard) && (OtherPin->PinType.PinCategory != UEdGraphSchema_K2::PC_SoftObject))
+		{
+			OutReason = LOCTEXT( "InvalidType_Reason", "Only arrays of soft object references can be loaded." ).ToString( );
+			return true;
+		}
+	}
+
+	return Super::IsConnectionDisallowed( MyPin, OtherPin, OutReason );
+}
+
+bool UK2Node_AsyncLoadForEach::IsCompatibleWithGraph( const UEdGraph* TargetGraph ) const
+{
+	// Latent, so only allowed in the places that latent functions are
+	const auto GraphType = TargetGraph->GetSchema( )->GetGraphType( TargetGraph );
+	if ((GraphType != GT_Ubergraph) && (GraphType != GT_Macro))
+		return false;
+
+	return Super::IsCompatibleWithGraph( TargetGraph );
+}
+
+void UK2Node_AsyncLoadForEach::PinConnectionListChanged( UEdGraphPin* Pin )
+{
+	Super::PinConnectionListChanged( Pin );
+
+	if (Pin == nullptr)
+		return;
+
+	if (Pin->PinName == ArrayPinName)
+	{
+		if (Pin->LinkedTo.Num( ) > 0)
+			SetArrayType( Pin->LinkedTo[ 0 ]->PinType );
+		else
+			SetArrayType( CoreTechK2Utilities::GetWildcardArrayType( ) );
+
+		CoreTechK2Utilities::RefreshAllowedConnections( this, GetElementPin( ) );
+	}
+}
+
+void UK2Node_AsyncLoadForEach::SetArrayType( const FEdGraphPinType &ArrayType )
+{
+	const auto ArrayPin = GetArrayPin( );
+	ArrayPin->PinType = ArrayType;
+
+	// The elements come out as hard references to whatever was loaded
+	const auto ElementPin = GetElementPin( );
+	ElementPin->PinType = ArrayType;
+	ElementPin->PinType.ContainerType = EPinContainerType::None;
+	ElementPin->PinType.bIsConst = false;
+	ElementPin->PinType.bIsReference = false;
+	if (ElementPin->PinType.PinCategory == UEdGraphSchema_K2::PC_SoftObject)
+		ElementPin->PinType.PinCategory = UEdGraphSchema_K2::PC_Object;
+
+	CoreTechK2Utilities::SetPinToolTip( ArrayPin, LOCTEXT( "ArrayPin_Tooltip", "Array of soft references to load and visit all elements of" ) );
+	CoreTechK2Utilities::SetPinToolTip( ElementPin, LOCTEXT( "ElementPin_Tooltip", "Loaded element of the Array, null if it failed to load" ) );
+}
+
+UEdGraphPin* UK2Node_AsyncLoadForEach::GetWorldContextPin( void ) const
+{
+	return FindPinChecked( CoreTechK2Utilities::PN_WorldContextObject );
+}
+
+UEdGraphPin* UK2Node_AsyncLoadForEach::GetArrayPin( void ) const
+{
+	return FindPinChecked( ArrayPinName );
+}
+
+UEdGraphPin* UK2Node_AsyncLoadForEach::GetChunkSizePin( void ) const
+{
+	return FindPinChecked( ChunkSizePinName );
+}
+
+UEdGraphPin* UK2Node_AsyncLoadForEach::GetBreakPin( void ) const
+{
+	return FindPinChecked( BreakPinName );
+}
+
+UEdGraphPin* UK2Node_AsyncLoadForEach::GetForEachPin( void ) const
+{
+	return FindPinChecked( UEdGraphSchema_K2::PN_Then );
+}
+
+UEdGraphPin* UK2Node_AsyncLoadForEach::GetElementPin( void ) const
+{
+	return FindPinChecked( ElementPinName );
+}
+
+UEdGraphPin* UK2Node_AsyncLoadForEach::GetArrayIndexPin( void ) const
+{
+	return FindPinChecked( ArrayIndexPinName );
+}
+
+UEdGraphPin* UK2Node_AsyncLoadForEach::GetCompletedPin( void ) const
+{
+	return FindPinChecked( CompletedPinName );
+}
+
+FText UK2Node_AsyncLoadForEach::GetNodeTitle( ENodeTitleType::Type TitleType ) const
+{
+	return LOCTEXT( "NodeTitle_NONE", "Async Load For Each (Native)" );
+}
+
+FText UK2Node_AsyncLoadForEach::GetTooltipText( ) const
+{
+	return LOCTEXT( "NodeToolTip", "Load an array of soft references in batches with the streamable manager, visiting each element once its batch has finished loading" );
+}
+
+FText UK2Node_AsyncLoadForEach::GetMenuCategory( ) const
+{
+	return LOCTEXT( "NodeMenu", "Core Utilities" );
+}
+
+FSlateIcon UK2Node_AsyncLoadForEach::GetIconAndTint( FLinearColor& OutColor ) const
+{
+	return FSlateIcon( "EditorStyle", "GraphEditor.Macro.ForEach_16x" );
+}
+
+void UK2Node_AsyncLoadForEach::GetMenuActions( FBlueprintActionDatabaseRegistrar& ActionRegistrar ) const
+{
+	CoreTechK2Utilities::DefaultGetMenuActions( this, ActionRegistrar );
+}
+
+#undef LOCTEXT_NAMESPACE
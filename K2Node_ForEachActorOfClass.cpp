@@ -0,0 +1,296 @@
+
+#include "K2Nodes/K2Node_ForEachActorOfClass.h"
+
+#include "CoreTechIterationLibrary.h"
+#include "CoreTechK2Utilities.h"
+
+// BlueprintGraph
+#include "K2Node_CallFunction.h"
+#include "K2Node_ExecutionSequence.h"
+#include "K2Node_IfThenElse.h"
+#include "K2Node_TemporaryVariable.h"
+
+// Engine
+#include "GameFramework/Actor.h"
+
+// KismetCompiler
+#include "KismetCompiler.h"
+
+// UnrealEd
+#include "Kismet2/BlueprintEditorUtils.h"
+
+#define LOCTEXT_NAMESPACE "K2Node_ForEachActorOfClass"
+
+const FName UK2Node_ForEachActorOfClass::ActorClassPinName( TEXT( "ActorClassPin" ) );
+const FName UK2Node_ForEachActorOfClass::BreakPinName( TEXT( "BreakPin" ) );
+const FName UK2Node_ForEachActorOfClass::ActorPinName( TEXT( "ActorPin" ) );
+const FName UK2Node_ForEachActorOfClass::CompletedPinName( TEXT( "CompletedPin" ) );
+
+void UK2Node_ForEachActorOfClass::AllocateDefaultPins( )
+{
+	Super::AllocateDefaultPins( );
+
+	// Execution pin
+	CreatePin( EGPD_Input, UEdGraphSchema_K2::PC_Exec, UEdGraphSchema_K2::PN_Execute );
+
+	// Only needed when the Blueprint can't provide the world itself
+	const auto WorldContextPin = CreatePin( EGPD_Input, UEdGraphSchema_K2::PC_Object, UObject::StaticClass( ), CoreTechK2Utilities::PN_WorldContextObject );
+	const auto Blueprint = GetBlueprint( );
+	WorldContextPin->bHidden = (Blueprint == nullptr) || FBlueprintEditorUtils::ImplementsGetWorld( Blueprint );
+
+	const auto ActorClassPin = CreatePin( EGPD_Input, UEdGraphSchema_K2::PC_Class, AActor::StaticClass( ), ActorClassPinName );
+	ActorClassPin->PinFriendlyName = LOCTEXT( "ActorClassPin_FriendlyName", "Actor Class" );
+	ActorClassPin->DefaultObject = AActor::StaticClass( );
+
+	const auto BreakPin = CreatePin( EGPD_Input, UEdGraphSchema_K2::PC_Exec, BreakPinName );
+	BreakPin->PinFriendlyName = LOCTEXT( "BreakPin_FriendlyName", "Break" );
+	BreakPin->bAdvancedView = true;
+
+	// For Each pin
+	const auto ForEachPin = CreatePin( EGPD_Output, UEdGraphSchema_K2::PC_Exec, UEdGraphSchema_K2::PN_Then );
+	ForEachPin->PinFriendlyName = LOCTEXT( "ForEachPin_FriendlyName", "Loop Body" );
+
+	const auto ActorPin = CreatePin( EGPD_Output, UEdGraphSchema_K2::PC_Object, AActor::StaticClass( ), ActorPinName );
+	ActorPin->PinFriendlyName = LOCTEXT( "ActorPin_FriendlyName", "Actor" );
+
+	const auto CompletedPin = CreatePin( EGPD_Output, UEdGraphSchema_K2::PC_Exec, CompletedPinName );
+	CompletedPin->PinFriendlyName = LOCTEXT( "CompletedPin_FriendlyName", "Completed" );
+	CompletedPin->PinToolTip = LOCTEXT( "CompletedPin_Tooltip", "Execution once all actors have been visited" ).ToString( );
+
+	CoreTechK2Utilities::SetPinToolTip( ActorClassPin, LOCTEXT( "ActorClassPin_Tooltip", "Class of actors to visit" ) );
+	CoreTechK2Utilities::SetPinToolTip( ActorPin, LOCTEXT( "ActorPin_Tooltip", "Actor of the class" ) );
+
+	if (AdvancedPinDisplay == ENodeAdvancedPins::NoPins)
+		AdvancedPinDisplay = ENodeAdvancedPins::Hidden;
+}
+
+void UK2Node_ForEachActorOfClass::PostReconstructNode( )
+{
+	Super::PostReconstructNode( );
+
+	// The class pin has its connections and default back now, so the actor type can be determined again
+	RefreshActorPinType( );
+}
+
+void UK2Node_ForEachActorOfClass::ExpandNode( FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph )
+{
+	Super::ExpandNode( CompilerContext, SourceGraph );
+
+	if (CheckForErrors( CompilerContext ))
+	{
+		// remove all the links to this node as they are no longer needed
+		BreakAllNodeLinks( );
+		return;
+	}
+
+	const auto K2Schema = CompilerContext.GetSchema( );
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// Cache off versions of all our important pins
+	const auto ExecPin = GetExecPin( );
+	const auto WorldContextPin = GetWorldContextPin( );
+	const auto ActorClassPin = GetActorClassPin( );
+	const auto BreakPin = GetBreakPin( );
+
+	const auto ForEachPin = GetForEachPin( );
+	const auto ActorPin = GetActorPin( );
+	const auto CompletedPin = GetCompletedPin( );
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// Create the cursor variable
+	const auto CreateTemporaryVariable = CompilerContext.SpawnIntermediateNode< UK2Node_TemporaryVariable >( this, SourceGraph );
+	CreateTemporaryVariable->VariableType.PinCategory = UEdGraphSchema_K2::PC_Struct;
+	CreateTemporaryVariable->VariableType.PinSubCategoryObject = FCoreTechActorCursor::StaticStruct( );
+	CreateTemporaryVariable->AllocateDefaultPins( );
+
+	const auto Temp_Variable = CreateTemporaryVariable->GetVariablePin( );
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// Point the cursor at the start of the world
+	const auto CallBegin = CompilerContext.SpawnIntermediateNode< UK2Node_CallFunction >( this, SourceGraph );
+	CallBegin->FunctionReference.SetExternalMember( GET_FUNCTION_NAME_CHECKED( UCoreTechIterationLibrary, ActorCursor_Begin ), UCoreTechIterationLibrary::StaticClass( ) );
+	CallBegin->AllocateDefaultPins( );
+
+	const auto Begin_Exec = CallBegin->GetExecPin( );
+	const auto Begin_WorldContext = CallBegin->FindPinChecked( TEXT( "WorldContextObject" ) );
+	const auto Begin_Cursor = CallBegin->FindPinChecked( TEXT( "Cursor" ) );
+	const auto Begin_Then = CallBegin->GetThenPin( );
+
+	CompilerContext.MovePinLinksToIntermediate( *ExecPin, *Begin_Exec );
+	CompilerContext.MovePinLinksToIntermediate( *WorldContextPin, *Begin_WorldContext );
+	Temp_Variable->MakeLinkTo( Begin_Cursor );
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// Step to the next actor, branching on whether there was one
+	const auto CallNext = CompilerContext.SpawnIntermediateNode< UK2Node_CallFunction >( this, SourceGraph );
+	CallNext->FunctionReference.SetExternalMember( GET_FUNCTION_NAME_CHECKED( UCoreTechIterationLibrary, ActorCursor_Next ), UCoreTechIterationLibrary::StaticClass( ) );
+	CallNext->AllocateDefaultPins( );
+
+	const auto Next_Exec = CallNext->GetExecPin( );
+	const auto Next_Cursor = CallNext->FindPinChecked( TEXT( "Cursor" ) );
+	const auto Next_Class = CallNext->FindPinChecked( TEXT( "ActorClass" ) );
+	const auto Next_Actor = CallNext->FindPinChecked( TEXT( "Actor" ) );
+	const auto Next_Return = CallNext->GetReturnValuePin( );
+	const auto Next_Then = CallNext->GetThenPin( );
+
+	// Coerce the actor type to the class being visited
+	Next_Actor->PinType = ActorPin->PinType;
+
+	Begin_Then->MakeLinkTo( Next_Exec );
+	Temp_Variable->MakeLinkTo( Next_Cursor );
+	CoreTechK2Utilities::MovePinLinksOrCopyDefaults( CompilerContext, ActorClassPin, Next_Class );
+	CompilerContext.MovePinLinksToIntermediate( *ActorPin, *Next_Actor );
+
+	const auto BranchOnNext = CompilerContext.SpawnIntermediateNode< UK2Node_IfThenElse >( this, SourceGraph );
+	BranchOnNext->AllocateDefaultPins( );
+
+	const auto Branch_Exec = BranchOnNext->GetExecPin( );
+	const auto Branch_Input = BranchOnNext->GetConditionPin( );
+	const auto Branch_Then = BranchOnNext->GetThenPin( );
+	const auto Branch_Else = BranchOnNext->GetElsePin( );
+
+	Next_Then->MakeLinkTo( Branch_Exec );
+	Next_Return->MakeLinkTo( Branch_Input );
+	CompilerContext.MovePinLinksToIntermediate( *CompletedPin, *Branch_Else );
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// Sequence the loop body and stepping to the next actor
+	const auto LoopSequence = CompilerContext.SpawnIntermediateNode< UK2Node_ExecutionSequence >( this, SourceGraph );
+	LoopSequence->AllocateDefaultPins( );
+
+	const auto Sequence_Exec = LoopSequence->GetExecPin( );
+	const auto Sequence_One = LoopSequence->GetThenPinGivenIndex( 0 );
+	const auto Sequence_Two = LoopSequence->GetThenPinGivenIndex( 1 );
+
+	Branch_Then->MakeLinkTo( Sequence_Exec );
+	CompilerContext.MovePinLinksToIntermediate( *ForEachPin, *Sequence_One );
+	Sequence_Two->MakeLinkTo( Next_Exec );
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// Break exhausts the cursor. The loop will then fail to find another actor on the next run of SequenceTwo
+	// and terminate without ever visiting the remaining actors.
+	const auto CallEnd = CompilerContext.SpawnIntermediateNode< UK2Node_CallFunction >( this, SourceGraph );
+	CallEnd->FunctionReference.SetExternalMember( GET_FUNCTION_NAME_CHECKED( UCoreTechIterationLibrary, ActorCursor_End ), UCoreTechIterationLibrary::StaticClass( ) );
+	CallEnd->AllocateDefaultPins( );
+
+	CompilerContext.MovePinLinksToIntermediate( *BreakPin, *CallEnd->GetExecPin( ) );
+	K2Schema->TryCreateConnection( Temp_Variable, CallEnd->FindPinChecked( TEXT( "Cursor" ) ) );
+
+	///////////////////////////////////////////////////////////////////////////////////
+	//
+	BreakAllNodeLinks( );
+}
+
+bool UK2Node_ForEachActorOfClass::CheckForErrors( const FKismetCompilerContext& CompilerContext )
+{
+	bool bError = false;
+
+	const auto ActorClassPin = GetActorClassPin( );
+	if ((ActorClassPin->LinkedTo.Num( ) == 0) && (ActorClassPin->DefaultObject == nullptr))
+	{
+		CompilerContext.MessageLog.Error( *LOCTEXT( "MissingClass_Error", "For Each Actor of Class node @@ must have a class of actor to visit." ).ToString( ), this );
+		bError = true;
+	}
+
+	return bError;
+}
+
+UClass* UK2Node_ForEachActorOfClass::GetActorClass( ) const
+{
+	const auto ActorClassPin = GetActorClassPin( );
+
+	UClass *ActorClass = nullptr;
+	if (ActorClassPin->LinkedTo.Num( ) > 0)
+		ActorClass = Cast< UClass >( ActorClassPin->LinkedTo[ 0 ]->PinType.PinSubCategoryObject.Get( ) );
+	else
+		ActorClass = Cast< UClass >( ActorClassPin->DefaultObject );
+
+	return (ActorClass != nullptr) ? ActorClass : AActor::StaticClass( );
+}
+
+void UK2Node_ForEachActorOfClass::RefreshActorPinType( )
+{
+	const auto ActorPin = GetActorPin( );
+
+	const auto ActorClass = GetActorClass( );
+	if (ActorPin->PinType.PinSubCategoryObject == ActorClass)
+		return;
+
+	ActorPin->PinType.PinSubCategoryObject = ActorClass;
+	CoreTechK2Utilities::SetPinToolTip( ActorPin, LOCTEXT( "ActorPin_Tooltip", "Actor of the class" ) );
+
+	CoreTechK2Utilities::RefreshAllowedConnections( this, ActorPin );
+}
+
+void UK2Node_ForEachActorOfClass::PinConnectionListChanged( UEdGraphPin* Pin )
+{
+	Super::PinConnectionListChanged( Pin );
+
+	if ((Pin != nullptr) && (Pin->PinName == ActorClassPinName))
+		RefreshActorPinType( );
+}
+
+void UK2Node_ForEachActorOfClass::PinDefaultValueChanged( UEdGraphPin* Pin )
+{
+	Super::PinDefaultValueChanged( Pin );
+
+	if ((Pin != nullptr) && (Pin->PinName == ActorClassPinName))
+		RefreshActorPinType( );
+}
+
+UEdGraphPin* UK2Node_ForEachActorOfClass::GetWorldContextPin( void ) const
+{
+	return FindPinChecked( CoreTechK2Utilities::PN_WorldContextObject );
+}
+
+UEdGraphPin* UK2Node_ForEachActorOfClass::GetActorClassPin( void ) const
+{
+	return FindPinChecked( ActorClassPinName );
+}
+
+UEdGraphPin* UK2Node_ForEachActorOfClass::GetBreakPin( void ) const
+{
+	return FindPinChecked( BreakPinName );
+}
+
+UEdGraphPin* UK2Node_ForEachActorOfClass::GetForEachPin( void ) const
+{
+	return FindPinChecked( UEdGraphSchema_K2::PN_Then );
+}
+
+UEdGraphPin* UK2Node_ForEachActorOfClass::GetActorPin( void ) const
+{
+	return FindPinChecked( ActorPinName );
+}
+
+UEdGraphPin* UK2Node_ForEachActorOfClass::GetCompletedPin( void ) const
+{
+	return FindPinChecked( CompletedPinName );
+}
+
+FText UK2Node_ForEachActorOfClass::GetNodeTitle( ENodeTitleType::Type TitleType ) const
+{
+	return LOCTEXT( "NodeTitle_NONE", "For Each Actor of Class (Native)" );
+}
+
+FText UK2Node_ForEachActorOfClass::GetTooltipText( ) const
+{
+	return LOCTEXT( "NodeToolTip", "Loop over each actor of a class in the world, without gathering them into an array first" );
+}
+
+FText UK2Node_ForEachActorOfClass::GetMenuCategory( ) const
+{
+	return LOCTEXT( "NodeMenu", "Core Utilities" );
+}
+
+FSlateIcon UK2Node_ForEachActorOfClass::GetIconAndTint( FLinearColor& OutColor ) const
+{
+	return FSlateIcon( "EditorStyle", "GraphEditor.Macro.ForEach_16x" );
+}
+
+void UK2Node_ForEachActorOfClass::GetMenuActions( FBlueprintActionDatabaseRegistrar& ActionRegistrar ) const
+{
+	CoreTechK2Utilities::DefaultGetMenuActions( this, ActionRegistrar );
+}
+
+#undef LOCTEXT_NAMESPACE
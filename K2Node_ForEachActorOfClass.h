@@ -0,0 +1,53 @@
+
+#pragma once
+
+#include "K2Node.h"
+
+#include "K2Node_ForEachActorOfClass.generated.h"
+
+UCLASS( )
+class CORETECHDEVELOPER_API UK2Node_ForEachActorOfClass : public UK2Node
+{
+	GENERATED_BODY( )
+public:
+
+	// Pin Accessors
+	UE_NODISCARD UEdGraphPin* GetWorldContextPin( void ) const;
+	UE_NODISCARD UEdGraphPin* GetActorClassPin( void ) const;
+	UE_NODISCARD UEdGraphPin* GetBreakPin( void ) const;
+
+	UE_NODISCARD UEdGraphPin* GetForEachPin( void ) const;
+	UE_NODISCARD UEdGraphPin* GetActorPin( void ) const;
+	UE_NODISCARD UEdGraphPin* GetCompletedPin( void ) const;
+
+	// K2Node API
+	UE_NODISCARD bool IsNodeSafeToIgnore( ) const override { return true; }
+	void GetMenuActions( FBlueprintActionDatabaseRegistrar& ActionRegistrar ) const override;
+	UE_NODISCARD FText GetMenuCategory( ) const override;
+	void PostReconstructNode( ) override;
+
+	// EdGraphNode API
+	void AllocateDefaultPins( ) override;
+	void ExpandNode( FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph ) override;
+	UE_NODISCARD FText GetNodeTitle( ENodeTitleType::Type TitleType ) const override;
+	UE_NODISCARD FText GetTooltipText( ) const override;
+	UE_NODISCARD FSlateIcon GetIconAndTint( FLinearColor& OutColor ) const override;
+	void PinConnectionListChanged( UEdGraphPin* Pin ) override;
+	void PinDefaultValueChanged( UEdGraphPin* Pin ) override;
+
+private:
+	// Pin Names
+	static const FName ActorClassPinName;
+	static const FName BreakPinName;
+	static const FName ActorPinName;
+	static const FName CompletedPinName;
+
+	// Determine if there is any configuration options that shouldn't be allowed
+	UE_NODISCARD bool CheckForErrors( const FKismetCompilerContext& CompilerContext );
+
+	// Find the class of actor that the node will visit
+	UE_NODISCARD UClass* GetActorClass( ) const;
+
+	// Update the actor pin to match the class being visited
+	void RefreshActorPinType( );
+};
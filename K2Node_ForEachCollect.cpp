@@ -0,0 +1,265 @@
+
+#include "K2Nodes/K2Node_ForEachCollect.h"
+
+#include "CoreTechArrayLibrary.h"
+#include "CoreTechK2Utilities.h"
+
+// BlueprintGraph
+#include "K2Node_CallFunction.h"
+#include "K2Node_TemporaryVariable.h"
+
+// Kismet
+#include "Kismet/KismetArrayLibrary.h"
+
+// KismetCompiler
+#include "KismetCompiler.h"
+
+#define LOCTEXT_NAMESPACE "K2Node_ForEachCollect"
+
+const FName UK2Node_ForEachCollect::CollectPinName( TEXT( "CollectPin" ) );
+const FName UK2Node_ForEachCollect::ResultPinName( TEXT( "ResultPin" ) );
+const FName UK2Node_ForEachCollect::CollectedPinName( TEXT( "CollectedPin" ) );
+
+UK2Node_ForEachCollect::UK2Node_ForEachCollect( )
+{
+	// The collection adds to the loop body, so it's never shared with another loop
+	bCanFuseWithNextLoop = false;
+}
+
+void UK2Node_ForEachCollect::AllocateDefaultPins( )
+{
+	Super::AllocateDefaultPins( );
+
+	const auto CollectPin = CreatePin( EGPD_Input, UEdGraphSchema_K2::PC_Exec, CollectPinName );
+	CollectPin->PinFriendlyName = LOCTEXT( "CollectPin_FriendlyName", "Collect" );
+	CollectPin->PinToolTip = LOCTEXT( "CollectPin_Tooltip", "Add Result to the Collected array, finishing the loop body for this element" ).ToString( );
+
+	const auto ResultPin = CreatePin( EGPD_Input, UEdGraphSchema_K2::PC_Wildcard, ResultPinName );
+	ResultPin->PinFriendlyName = LOCTEXT( "ResultPin_FriendlyName", "Result" );
+
+	const auto CollectedPin = CreatePin( EGPD_Output, UEdGraphSchema_K2::PC_Wildcard, CollectedPinName );
+	CollectedPin->PinType.ContainerType = EPinContainerType::Array;
+	CollectedPin->PinFriendlyName = LOCTEXT( "CollectedPin_FriendlyName", "Collected" );
+
+	CoreTechK2Utilities::SetPinToolTip( ResultPin, LOCTEXT( "ResultPin_Tooltip", "Value to add to the Collected array when Collect is run" ) );
+	CoreTechK2Utilities::SetPinToolTip( CollectedPin, LOCTEXT( "CollectedPin_Tooltip", "Every Result that was collected, in the order they were collected" ) );
+}
+
+void UK2Node_ForEachCollect::ReallocatePinsDuringReconstruction( TArray< UEdGraphPin* > &OldPins )
+{
+	Super::ReallocatePinsDuringReconstruction( OldPins );
+
+	if (const auto OldResultType = CoreTechK2Utilities::GetReconstructedPinType( OldPins, ResultPinName ))
+		SetResultType( *OldResultType );
+}
+
+void UK2Node_ForEachCollect::PostPasteNode( )
+{
+	Super::PostPasteNode( );
+
+	if (CoreTechK2Utilities::IsPinTypeStale( GetResultPin( ) ) || CoreTechK2Utilities::IsPinTypeStale( GetCollectedPin( ) ))
+		PinConnectionListChanged( GetResultPin( ) );
+}
+
+void UK2Node_ForEachCollect::ExpandNode( FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph )
+{
+	if (CheckForCollectErrors( CompilerContext ))
+	{
+		// remove all the links to this node as they are no longer needed
+		BreakAllNodeLinks( );
+		return;
+	}
+
+	const auto ResultPin = GetResultPin( );
+	const auto CollectedPin = GetCollectedPin( );
+
+	// Without a result type nothing can be collected, so this is only a regular loop
+	if (ResultPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Wildcard)
+	{
+		Super::ExpandNode( CompilerContext, SourceGraph );
+		return;
+	}
+
+	// The collection is wired up to the pins of this node so that the loop expansion picks it up from there
+	const auto ExecPin = GetExecPin( );
+	const auto ArrayPin = GetArrayPin( );
+	const auto CollectPin = GetCollectPin( );
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// Create the array that the results are collected into
+	const auto CreateCollectedVariable = CompilerContext.SpawnIntermediateNode< UK2Node_TemporaryVariable >( this, SourceGraph );
+	CreateCollectedVariable->VariableType = CollectedPin->PinType;
+	CreateCollectedVariable->AllocateDefaultPins( );
+
+	const auto Temp_Collected = CreateCollectedVariable->GetVariablePin( );
+	CompilerContext.MovePinLinksToIntermediate( *CollectedPin, *Temp_Collected );
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// Empty the collected array on entry to the loop, making room for a result from every element up front
+	const auto ResetCollected = CompilerContext.SpawnIntermediateNode< UK2Node_CallFunction >( this, SourceGraph );
+	ResetCollected->FunctionReference.SetExternalMember( GET_FUNCTION_NAME_CHECKED( UCoreTechArrayLibrary, Array_ResetWithCapacity ), UCoreTechArrayLibrary::StaticClass( ) );
+	ResetCollected->AllocateDefaultPins( );
+
+	const auto Reset_Exec = ResetCollected->GetExecPin( );
+	const auto Reset_Array = ResetCollected->FindPinChecked( TEXT( "TargetArray" ) );
+	const auto Reset_Capacity = ResetCollected->FindPinChecked( TEXT( "Capacity" ) );
+	const auto Reset_Then = ResetCollected->GetThenPin( );
+
+	// Coerce the wildcard pin types
+	Reset_Array->PinType = CollectedPin->PinType;
+	Reset_Array->MakeLinkTo( Temp_Collected );
+
+	CompilerContext.MovePinLinksToIntermediate( *ExecPin, *Reset_Exec );
+	Reset_Then->MakeLinkTo( ExecPin );
+
+	const auto GetArrayLength = CompilerContext.SpawnIntermediateNode< UK2Node_CallFunction >( this, SourceGraph );
+	GetArrayLength->FunctionReference.SetExternalMember( GET_FUNCTION_NAME_CHECKED( UKismetArrayLibrary, Array_Length ), UKismetArrayLibrary::StaticClass( ) );
+	GetArrayLength->AllocateDefaultPins( );
+
+	const auto ArrayLength_Array = GetArrayLength->FindPinChecked( TEXT( "TargetArray" ) );
+	const auto ArrayLength_Return = GetArrayLength->GetReturnValuePin( );
+
+	// Coerce the wildcard pin types
+	ArrayLength_Array->PinType = ArrayPin->PinType;
+
+	CompilerContext.CopyPinLinksToIntermediate( *ArrayPin, *ArrayLength_Array );
+	ArrayLength_Return->MakeLinkTo( Reset_Capacity );
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// Add the result to the end of the collected array. Collecting once per element stays within the space made for it up front,
+	// collecting more than once for an element grows the array as usual.
+	const auto AddResult = CompilerContext.SpawnIntermediateNode< UK2Node_CallFunction >( this, SourceGraph );
+	AddResult->FunctionReference.SetExternalMember( GET_FUNCTION_NAME_CHECKED( UKismetArrayLibrary, Array_Add ), UKismetArrayLibrary::StaticClass( ) );
+	AddResult->AllocateDefaultPins( );
+
+	const auto Add_Exec = AddResult->GetExecPin( );
+	const auto Add_Array = AddResult->FindPinChecked( TEXT( "TargetArray" ) );
+	const auto Add_Item = AddResult->FindPinChecked( TEXT( "NewItem" ) );
+
+	// Coerce the wildcard pin types
+	Add_Array->PinType = CollectedPin->PinType;
+	Add_Item->PinType = ResultPin->PinType;
+
+	Add_Array->MakeLinkTo( Temp_Collected );
+	CompilerContext.MovePinLinksToIntermediate( *CollectPin, *Add_Exec );
+	CoreTechK2Utilities::MovePinLinksOrCopyDefaults( CompilerContext, ResultPin, Add_Item );
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// Expand the loop itself
+	Super::ExpandNode( CompilerContext, SourceGraph );
+}
+
+bool UK2Node_ForEachCollect::CheckForCollectErrors( const FKismetCompilerContext& CompilerContext )
+{
+	bool bError = false;
+
+	const auto bCollects = (GetCollectPin( )->LinkedTo.Num( ) > 0);
+
+	if (bCollects && (GetResultPin( )->PinType.PinCategory == UEdGraphSchema_K2::PC_Wildcard))
+	{
+		CompilerContext.MessageLog.Error( *LOCTEXT( "MissingResult_Error", "For Each With Collect node @@ must have a Result connected to know what to collect." ).ToString( ), this );
+		bError = true;
+	}
+	else if (!bCollects && (GetCollectedPin( )->LinkedTo.Num( ) > 0))
+	{
+		CompilerContext.MessageLog.Warning( *LOCTEXT( "NeverCollects_Warning", "For Each With Collect node @@ never runs Collect, so the Collected array will always be empty." ).ToString( ), this );
+	}
+
+	return bError;
+}
+
+bool UK2Node_ForEachCollect::IsConnectionDisallowed( const UEdGraphPin* MyPin, const UEdGraphPin* OtherPin, FString& OutReason ) const
+{
+	if (MyPin->PinName == ResultPinName)
+	{
+		if (OtherPin->PinType.IsContainer( ))
+		{
+			OutReason = LOCTEXT( "ContainerResult_Reason", "Arrays of containers can't be collected, the Result must be a single value." ).ToString( );
+			return true;
+		}
+	}
+	else if (MyPin->PinName == CollectedPinName)
+	{
+		if (OtherPin->PinType.IsContainer( ) && !OtherPin->PinType.IsArray( ))
+		{
+			OutReason = LOCTEXT( "NotArray_Reason", "Results are only collected into arrays." ).ToString( );
+			return true;
+		}
+	}
+
+	return Super::IsConnectionDisallowed( MyPin, OtherPin, OutReason );
+}
+
+void UK2Node_ForEachCollect::PinConnectionListChanged( UEdGraphPin* Pin )
+{
+	Super::PinConnectionListChanged( Pin );
+
+	if (Pin == nullptr)
+		return;
+
+	if ((Pin->PinName == ResultPinName) || (Pin->PinName == CollectedPinName))
+	{
+		// Either the result or the use of the collected array can determine the type for both
+		const auto ResultPin = GetResultPin( );
+		const auto CollectedPin = GetCollectedPin( );
+
+		if (ResultPin->LinkedTo.Num( ) > 0)
+		{
+			SetResultType( ResultPin->LinkedTo[ 0 ]->PinType );
+		}
+		else if (CollectedPin->LinkedTo.Num( ) > 0)
+		{
+			SetResultType( CollectedPin->LinkedTo[ 0 ]->PinType );
+		}
+		else
+		{
+			FEdGraphPinType WildcardType;
+			WildcardType.PinCategory = UEdGraphSchema_K2::PC_Wildcard;
+
+			SetResultType( WildcardType );
+		}
+	}
+}
+
+void UK2Node_ForEachCollect::SetResultType( const FEdGraphPinType &ResultType )
+{
+	const auto ResultPin = GetResultPin( );
+	ResultPin->PinType = ResultType;
+	ResultPin->PinType.ContainerType = EPinContainerType::None;
+	ResultPin->PinType.bIsConst = false;
+	ResultPin->PinType.bIsReference = false;
+
+	const auto CollectedPin = GetCollectedPin( );
+	CollectedPin->PinType = ResultPin->PinType;
+	CollectedPin->PinType.ContainerType = EPinContainerType::Array;
+
+	CoreTechK2Utilities::SetPinToolTip( ResultPin, LOCTEXT( "ResultPin_Tooltip", "Value to add to the Collected array when Collect is run" ) );
+	CoreTechK2Utilities::SetPinToolTip( CollectedPin, LOCTEXT( "CollectedPin_Tooltip", "Every Result that was collected, in the order they were collected" ) );
+}
+
+UEdGraphPin* UK2Node_ForEachCollect::GetCollectPin( void ) const
+{
+	return FindPinChecked( CollectPinName );
+}
+
+UEdGraphPin* UK2Node_ForEachCollect::GetResultPin( void ) const
+{
+	return FindPinChecked( ResultPinName );
+}
+
+UEdGraphPin* UK2Node_ForEachCollect::GetCollectedPin( void ) const
+{
+	return FindPinChecked( CollectedPinName );
+}
+
+FText UK2Node_ForEachCollect::GetNodeTitle( ENodeTitleType::Type TitleType ) const
+{
+	return LOCTEXT( "NodeTitle_NONE", "For Each Loop With Collect (Native)" );
+}
+
+FText UK2Node_ForEachCollect::GetTooltipText( ) const
+{
+	return LOCTEXT( "NodeToolTip", "Loop over each element of an array, building a new array from the results that the loop body collects. Room for a result from every element is made when the loop starts so collecting never reallocates, and elements that don't run Collect are left out." );
+}
+
+#undef LOCTEXT_NAMESPACE
\ No newline at end of file
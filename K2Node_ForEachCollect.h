@@ -0,0 +1,43 @@
+
+#pragma once
+
+#include "K2Nodes/K2Node_NativeForEach.h"
+
+#include "K2Node_ForEachCollect.generated.h"
+
+UCLASS( )
+class CORETECHDEVELOPER_API UK2Node_ForEachCollect : public UK2Node_NativeForEach
+{
+	GENERATED_BODY( )
+public:
+	UK2Node_ForEachCollect( );
+
+	// Pin Accessors
+	UE_NODISCARD UEdGraphPin* GetCollectPin( void ) const;
+	UE_NODISCARD UEdGraphPin* GetResultPin( void ) const;
+	UE_NODISCARD UEdGraphPin* GetCollectedPin( void ) const;
+
+	// K2Node API
+	UE_NODISCARD bool IsConnectionDisallowed( const UEdGraphPin* MyPin, const UEdGraphPin* OtherPin, FString& OutReason ) const override;
+
+	// EdGraphNode API
+	void AllocateDefaultPins( ) override;
+	void ExpandNode( FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph ) override;
+	UE_NODISCARD FText GetNodeTitle( ENodeTitleType::Type TitleType ) const override;
+	UE_NODISCARD FText GetTooltipText( ) const override;
+	void PinConnectionListChanged( UEdGraphPin* Pin ) override;
+	void PostPasteNode( ) override;
+	void ReallocatePinsDuringReconstruction( TArray< UEdGraphPin* > &OldPins ) override;
+
+private:
+	// Pin Names
+	static const FName CollectPinName;
+	static const FName ResultPinName;
+	static const FName CollectedPinName;
+
+	// Determine if there is any configuration options that shouldn't be allowed
+	UE_NODISCARD bool CheckForCollectErrors( const FKismetCompilerContext& CompilerContext );
+
+	// Update the types of the result and collected pins from the type of a single result
+	void SetResultType( const FEdGraphPinType &ResultType );
+};
\ No newline at end of file
@@ -0,0 +1,398 @@
+
+#include "K2Nodes/K2Node_ForEachDataTableRow.h"
+
+#include "CoreTechIterationLibrary.h"
+#include "CoreTechK2Utilities.h"
+
+// BlueprintGraph
+#include "K2Node_AssignmentStatement.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_ExecutionSequence.h"
+#include "K2Node_IfThenElse.h"
+#include "K2Node_TemporaryVariable.h"
+
+// Engine
+#include "Engine/DataTable.h"
+
+// KismetCompiler
+#include "KismetCompiler.h"
+
+// UnrealEd
+#include "Kismet2/BlueprintEditorUtils.h"
+
+#define LOCTEXT_NAMESPACE "K2Node_ForEachDataTableRow"
+
+const FName UK2Node_ForEachDataTableRow::DataTablePinName( TEXT( "DataTablePin" ) );
+const FName UK2Node_ForEachDataTableRow::BreakPinName( TEXT( "BreakPin" ) );
+const FName UK2Node_ForEachDataTableRow::RowNamePinName( TEXT( "RowNamePin" ) );
+const FName UK2Node_ForEachDataTableRow::RowPinName( TEXT( "RowPin" ) );
+const FName UK2Node_ForEachDataTableRow::CompletedPinName( TEXT( "CompletedPin" ) );
+
+void UK2Node_ForEachDataTableRow::AllocateDefaultPins( )
+{
+	Super::AllocateDefaultPins( );
+
+	// Execution pin
+	CreatePin( EGPD_Input, UEdGraphSchema_K2::PC_Exec, UEdGraphSchema_K2::PN_Execute );
+
+	const auto DataTablePin = CreatePin( EGPD_Input, UEdGraphSchema_K2::PC_Object, UDataTable::StaticClass( ), DataTablePinName );
+	DataTablePin->PinFriendlyName = LOCTEXT( "DataTablePin_FriendlyName", "Data Table" );
+
+	const auto BreakPin = CreatePin( EGPD_Input, UEdGraphSchema_K2::PC_Exec, BreakPinName );
+	BreakPin->PinFriendlyName = LOCTEXT( "BreakPin_FriendlyName", "Break" );
+	BreakPin->bAdvancedView = true;
+
+	// For Each pin
+	const auto ForEachPin = CreatePin( EGPD_Output, UEdGraphSchema_K2::PC_Exec, UEdGraphSchema_K2::PN_Then );
+	ForEachPin->PinFriendlyName = LOCTEXT( "ForEachPin_FriendlyName", "Loop Body" );
+
+	const auto RowNamePin = CreatePin( EGPD_Output, UEdGraphSchema_K2::PC_Name, RowNamePinName );
+	RowNamePin->PinFriendlyName = LOCTEXT( "RowNamePin_FriendlyName", "Row Name" );
+	RowNamePin->PinToolTip = LOCTEXT( "RowNamePin_Tooltip", "Name of the Row in the Data Table" ).ToString( );
+
+	const auto RowPin = CreatePin( EGPD_Output, UEdGraphSchema_K2::PC_Wildcard, RowPinName );
+	RowPin->PinFriendlyName = LOCTEXT( "RowPin_FriendlyName", "Row" );
+
+	const auto CompletedPin = CreatePin( EGPD_Output, UEdGraphSchema_K2::PC_Exec, CompletedPinName );
+	CompletedPin->PinFriendlyName = LOCTEXT( "CompletedPin_FriendlyName", "Completed" );
+	CompletedPin->PinToolTip = LOCTEXT( "CompletedPin_Tooltip", "Execution once all rows have been visited" ).ToString( );
+
+	CoreTechK2Utilities::SetPinToolTip( DataTablePin, LOCTEXT( "DataTablePin_Tooltip", "Data Table to visit all rows of" ) );
+	CoreTechK2Utilities::SetPinToolTip( RowPin, LOCTEXT( "RowPin_Tooltip", "Copy of the Row data" ) );
+
+	if (AdvancedPinDisplay == ENodeAdvancedPins::NoPins)
+		AdvancedPinDisplay = ENodeAdvancedPins::Hidden;
+}
+
+void UK2Node_ForEachDataTableRow::ReallocatePinsDuringReconstruction( TArray< UEdGraphPin* > &OldPins )
+{
+	Super::ReallocatePinsDuringReconstruction( OldPins );
+
+	if (const auto OldRowType = CoreTechK2Utilities::GetReconstructedPinType( OldPins, RowPinName ))
+		SetRowType( *OldRowType );
+}
+
+#if WITH_EDITOR
+void UK2Node_ForEachDataTableRow::PostEditChangeProperty( FPropertyChangedEvent &PropertyChangedEvent )
+{
+	Super::PostEditChangeProperty( PropertyChangedEvent );
+
+	bool bRefresh = false;
+
+	if (PropertyChangedEvent.GetPropertyName( ) == GET_MEMBER_NAME_CHECKED( UK2Node_ForEachDataTableRow, bReadRowByReference ))
+	{
+		CoreTechK2Utilities::RefreshStructMemberPins( this, GetRowPin( ), bReadRowByReference );
+		bRefresh = true;
+	}
+	else if (PropertyChangedEvent.GetPropertyName( ) == GET_MEMBER_NAME_CHECKED( UK2Node_ForEachDataTableRow, RowStruct ))
+	{
+		RefreshRowType( );
+		bRefresh = true;
+	}
+
+	if (bRefresh)
+	{
+		// Poke the graph to update the visuals based on the above changes
+		GetGraph( )->NotifyGraphChanged( );
+		FBlueprintEditorUtils::MarkBlueprintAsModified( GetBlueprint( ) );
+	}
+}
+#endif
+
+void UK2Node_ForEachDataTableRow::ExpandNode( FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph )
+{
+	Super::ExpandNode( CompilerContext, SourceGraph );
+
+	if (CheckForErrors( CompilerContext ))
+	{
+		// remove all the links to this node as they are no longer needed
+		BreakAllNodeLinks( );
+		return;
+	}
+
+	const auto K2Schema = CompilerContext.GetSchema( );
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// Cache off versions of all our important pins
+	const auto ExecPin = GetExecPin( );
+	const auto DataTablePin = GetDataTablePin( );
+	const auto BreakPin = GetBreakPin( );
+
+	const auto ForEachPin = GetForEachPin( );
+	const auto RowNamePin = GetRowNamePin( );
+	const auto RowPin = GetRowPin( );
+	const auto CompletedPin = GetCompletedPin( );
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// Create a cursor variable, an index into the row storage of the table
+	const auto CreateTemporaryVariable = CompilerContext.SpawnIntermediateNode< UK2Node_TemporaryVariable >( this, SourceGraph );
+	CreateTemporaryVariable->VariableType.PinCategory = UEdGraphSchema_K2::PC_Int;
+	CreateTemporaryVariable->AllocateDefaultPins( );
+
+	const auto Temp_Variable = CreateTemporaryVariable->GetVariablePin( );
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// Initialize the cursor to before the first row
+	const auto InitTemporaryVariable = CompilerContext.SpawnIntermediateNode< UK2Node_AssignmentStatement >( this, SourceGraph );
+	InitTemporaryVariable->AllocateDefaultPins( );
+
+	const auto Init_Exec = InitTemporaryVariable->GetExecPin( );
+	const auto Init_Variable = InitTemporaryVariable->GetVariablePin( );
+	const auto Init_Value = InitTemporaryVariable->GetValuePin( );
+	const auto Init_Then = InitTemporaryVariable->GetThenPin( );
+
+	CompilerContext.MovePinLinksToIntermediate( *ExecPin, *Init_Exec );
+	K2Schema->TryCreateConnection( Init_Variable, Temp_Variable );
+	Init_Value->DefaultValue = LexToString( INDEX_NONE );
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// Step to the next row, branching on whether there was one
+	const auto CallNext = CompilerContext.SpawnIntermediateNode< UK2Node_CallFunction >( this, SourceGraph );
+	CallNext->FunctionReference.SetExternalMember( GET_FUNCTION_NAME_CHECKED( UCoreTechIterationLibrary, DataTable_NextRow ), UCoreTechIterationLibrary::StaticClass( ) );
+	CallNext->AllocateDefaultPins( );
+
+	const auto Next_Exec = CallNext->GetExecPin( );
+	const auto Next_DataTable = CallNext->FindPinChecked( TEXT( "DataTable" ) );
+	const auto Next_Cursor = CallNext->FindPinChecked( TEXT( "Cursor" ) );
+	const auto Next_RowName = CallNext->FindPinChecked( TEXT( "RowName" ) );
+	const auto Next_Return = CallNext->GetReturnValuePin( );
+	const auto Next_Then = CallNext->GetThenPin( );
+
+	Init_Then->MakeLinkTo( Next_Exec );
+	CoreTechK2Utilities::CopyPinLinksOrDefaults( CompilerContext, DataTablePin, Next_DataTable );
+	Temp_Variable->MakeLinkTo( Next_Cursor );
+	CompilerContext.MovePinLinksToIntermediate( *RowNamePin, *Next_RowName );
+
+	const auto BranchOnNext = CompilerContext.SpawnIntermediateNode< UK2Node_IfThenElse >( this, SourceGraph );
+	BranchOnNext->AllocateDefaultPins( );
+
+	const auto Branch_Exec = BranchOnNext->GetExecPin( );
+	const auto Branch_Input = BranchOnNext->GetConditionPin( );
+	const auto Branch_Then = BranchOnNext->GetThenPin( );
+	const auto Branch_Else = BranchOnNext->GetElsePin( );
+
+	Next_Then->MakeLinkTo( Branch_Exec );
+	Next_Return->MakeLinkTo( Branch_Input );
+	CompilerContext.MovePinLinksToIntermediate( *CompletedPin, *Branch_Else );
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// Sequence the loop body and stepping to the next row
+	const auto LoopSequence = CompilerContext.SpawnIntermediateNode< UK2Node_ExecutionSequence >( this, SourceGraph );
+	LoopSequence->AllocateDefaultPins( );
+
+	const auto Sequence_Exec = LoopSequence->GetExecPin( );
+	const auto Sequence_One = LoopSequence->GetThenPinGivenIndex( 0 );
+	const auto Sequence_Two = LoopSequence->GetThenPinGivenIndex( 1 );
+
+	Branch_Then->MakeLinkTo( Sequence_Exec );
+	CompilerContext.MovePinLinksToIntermediate( *ForEachPin, *Sequence_One );
+	Sequence_Two->MakeLinkTo( Next_Exec );
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// Only copy the whole row if something actually wants it
+	if (RowPin->LinkedTo.Num( ) > 0)
+	{
+		const auto CallGetRow = CompilerContext.SpawnIntermediateNode< UK2Node_CallFunction >( this, SourceGraph );
+		CallGetRow->FunctionReference.SetExternalMember( GET_FUNCTION_NAME_CHECKED( UCoreTechIterationLibrary, DataTable_GetRow ), UCoreTechIterationLibrary::StaticClass( ) );
+		CallGetRow->AllocateDefaultPins( );
+
+		const auto GetRow_DataTable = CallGetRow->FindPinChecked( TEXT( "DataTable" ) );
+		const auto GetRow_Cursor = CallGetRow->FindPinChecked( TEXT( "Cursor" ) );
+		const auto GetRow_OutRow = CallGetRow->FindPinChecked( TEXT( "OutRow" ) );
+
+		// Coerce the wildcard pin types
+		GetRow_OutRow->PinType = RowPin->PinType;
+
+		CoreTechK2Utilities::CopyPinLinksOrDefaults( CompilerContext, DataTablePin, GetRow_DataTable );
+		Temp_Variable->MakeLinkTo( GetRow_Cursor );
+		CompilerContext.MovePinLinksToIntermediate( *RowPin, *GetRow_OutRow );
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// Read any projected members directly out of the table
+	for (const auto Member : CoreTechK2Utilities::GetProjectableStructMembers( K2Schema, CoreTechK2Utilities::GetPinTypeStruct( RowPin->PinType ) ))
+	{
+		const auto MemberPin = FindPin( CoreTechK2Utilities::GetStructMemberPinName( RowPinName, Member ) );
+		if ((MemberPin == nullptr) || (MemberPin->LinkedTo.Num( ) == 0))
+			continue;
+
+		const auto GetMember = CompilerContext.SpawnIntermediateNode< UK2Node_CallFunction >( this, SourceGraph );
+		GetMember->FunctionReference.SetExternalMember( GET_FUNCTION_NAME_CHECKED( UCoreTechIterationLibrary, DataTable_GetRowMember ), UCoreTechIterationLibrary::StaticClass( ) );
+		GetMember->AllocateDefaultPins( );
+
+		const auto GetMember_DataTable = GetMember->FindPinChecked( TEXT( "DataTable" ) );
+		const auto GetMember_Cursor = GetMember->FindPinChecked( TEXT( "Cursor" ) );
+		const auto GetMember_Name = GetMember->FindPinChecked( TEXT( "MemberName" ) );
+		const auto GetMember_Value = GetMember->FindPinChecked( TEXT( "Value" ) );
+
+		// Coerce the wildcard pin types
+		GetMember_Value->PinType = MemberPin->PinType;
+
+		CoreTechK2Utilities::CopyPinLinksOrDefaults( CompilerContext, DataTablePin, GetMember_DataTable );
+		Temp_Variable->MakeLinkTo( GetMember_Cursor );
+		GetMember_Name->DefaultValue = Member->GetName( );
+		CompilerContext.MovePinLinksToIntermediate( *MemberPin, *GetMember_Value );
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// Break moves the cursor past the end of the table. The loop will then fail to find another row
+	// on the next run of SequenceTwo and terminate.
+	const auto SetVariable = CompilerContext.SpawnIntermediateNode< UK2Node_AssignmentStatement >( this, SourceGraph );
+	SetVariable->AllocateDefaultPins( );
+
+	const auto Set_Exec = SetVariable->GetExecPin( );
+	const auto Set_Variable = SetVariable->GetVariablePin( );
+	const auto Set_Value = SetVariable->GetValuePin( );
+
+	CompilerContext.MovePinLinksToIntermediate( *BreakPin, *Set_Exec );
+	K2Schema->TryCreateConnection( Temp_Variable, Set_Variable );
+	Set_Value->DefaultValue = LexToString( MAX_int32 );
+
+	///////////////////////////////////////////////////////////////////////////////////
+	//
+	BreakAllNodeLinks( );
+}
+
+bool UK2Node_ForEachDataTableRow::CheckForErrors( const FKismetCompilerContext& CompilerContext )
+{
+	bool bError = false;
+
+	const auto DataTablePin = GetDataTablePin( );
+	if ((DataTablePin->LinkedTo.Num( ) == 0) && (DataTablePin->DefaultObject == nullptr))
+	{
+		CompilerContext.MessageLog.Error( *LOCTEXT( "MissingDataTable_Error", "For Each Data Table Row node @@ must have a data table to iterate." ).ToString( ), this );
+		bError = true;
+	}
+
+	const auto RowPin = GetRowPin( );
+	if ((RowPin->LinkedTo.Num( ) > 0) && (CoreTechK2Utilities::GetPinTypeStruct( RowPin->PinType ) == nullptr))
+	{
+		CompilerContext.MessageLog.Error( *LOCTEXT( "UnknownRow_Error", "For Each Data Table Row node @@ doesn't know the type of the rows. Pick a data table, set the Row Struct or connect the row to a struct." ).ToString( ), this );
+		bError = true;
+	}
+
+	const auto DataTable = Cast< UDataTable >( DataTablePin->DefaultObject );
+	if ((RowStruct != nullptr) && (DataTablePin->LinkedTo.Num( ) == 0) && (DataTable != nullptr) && (DataTable->RowStruct != nullptr) && !DataTable->RowStruct->IsChildOf( RowStruct ))
+	{
+		CompilerContext.MessageLog.Error( *LOCTEXT( "MismatchedRow_Error", "For Each Data Table Row node @@ has a Row Struct that doesn't match the rows of the data table." ).ToString( ), this );
+		bError = true;
+	}
+
+	return bError;
+}
+
+void UK2Node_ForEachDataTableRow::RefreshRowType( )
+{
+	const auto DataTablePin = GetDataTablePin( );
+	const auto RowPin = GetRowPin( );
+
+	// An explicit row struct or a specific table is the authority on the type, otherwise go with whatever the row is being used as.
+	// With none of those the type stays as it was, so that unlinking the row doesn't throw away the member pins.
+	FEdGraphPinType RowType = RowPin->PinType;
+
+	const auto DataTable = Cast< UDataTable >( DataTablePin->DefaultObject );
+	if (RowStruct != nullptr)
+	{
+		RowType.PinCategory = UEdGraphSchema_K2::PC_Struct;
+		RowType.PinSubCategoryObject = RowStruct;
+	}
+	else if ((DataTablePin->LinkedTo.Num( ) == 0) && (DataTable != nullptr) && (DataTable->RowStruct != nullptr))
+	{
+		RowType.PinCategory = UEdGraphSchema_K2::PC_Struct;
+		RowType.PinSubCategoryObject = DataTable->RowStruct;
+	}
+	else if ((RowPin->LinkedTo.Num( ) > 0) && (RowPin->LinkedTo[ 0 ]->PinType.PinCategory == UEdGraphSchema_K2::PC_Struct))
+	{
+		RowType.PinCategory = UEdGraphSchema_K2::PC_Struct;
+		RowType.PinSubCategoryObject = RowPin->LinkedTo[ 0 ]->PinType.PinSubCategoryObject;
+	}
+
+	if (RowPin->PinType == RowType)
+		return;
+
+	SetRowType( RowType );
+
+	CoreTechK2Utilities::RefreshAllowedConnections( this, RowPin );
+}
+
+void UK2Node_ForEachDataTableRow::SetRowType( const FEdGraphPinType &RowType )
+{
+	const auto RowPin = GetRowPin( );
+	RowPin->PinType = RowType;
+
+	CoreTechK2Utilities::SetPinToolTip( RowPin, LOCTEXT( "RowPin_Tooltip", "Copy of the Row data" ) );
+	CoreTechK2Utilities::RefreshStructMemberPins( this, RowPin, bReadRowByReference );
+}
+
+void UK2Node_ForEachDataTableRow::PinConnectionListChanged( UEdGraphPin* Pin )
+{
+	Super::PinConnectionListChanged( Pin );
+
+	if ((Pin != nullptr) && ((Pin->PinName == DataTablePinName) || (Pin->PinName == RowPinName)))
+		RefreshRowType( );
+}
+
+void UK2Node_ForEachDataTableRow::PinDefaultValueChanged( UEdGraphPin* Pin )
+{
+	Super::PinDefaultValueChanged( Pin );
+
+	if ((Pin != nullptr) && (Pin->PinName == DataTablePinName))
+		RefreshRowType( );
+}
+
+UEdGraphPin* UK2Node_ForEachDataTableRow::GetDataTablePin( void ) const
+{
+	return FindPinChecked( DataTablePinName );
+}
+
+UEdGraphPin* UK2Node_ForEachDataTableRow::GetBreakPin( void ) const
+{
+	return FindPinChecked( BreakPinName );
+}
+
+UEdGraphPin* UK2Node_ForEachDataTableRow::GetForEachPin( void ) const
+{
+	return FindPinChecked( UEdGraphSchema_K2::PN_Then );
+}
+
+UEdGraphPin* UK2Node_ForEachDataTableRow::GetRowNamePin( void ) const
+{
+	return FindPinChecked( RowNamePinName );
+}
+
+UEdGraphPin* UK2Node_ForEachDataTableRow::GetRowPin( void ) const
+{
+	return FindPinChecked( RowPinName );
+}
+
+UEdGraphPin* UK2Node_ForEachDataTableRow::GetCompletedPin( void ) const
+{
+	return FindPinChecked( CompletedPinName );
+}
+
+FText UK2Node_ForEachDataTableRow::GetNodeTitle( ENodeTitleType::Type TitleType ) const
+{
+	return LOCTEXT( "NodeTitle_NONE", "For Each Data Table Row (Native)" );
+}
+
+FText UK2Node_ForEachDataTableRow::GetTooltipText( ) const
+{
+	return LOCTEXT( "NodeToolTip", "Loop over each row of a data table, reading the rows in place instead of looking each one up by name" );
+}
+
+FText UK2Node_ForEachDataTableRow::GetMenuCategory( ) const
+{
+	return LOCTEXT( "NodeMenu", "Core Utilities" );
+}
+
+FSlateIcon UK2Node_ForEachDataTableRow::GetIconAndTint( FLinearColor& OutColor ) const
+{
+	return FSlateIcon( "EditorStyle", "GraphEditor.Macro.ForEach_16x" );
+}
+
+void UK2Node_ForEachDataTableRow::GetMenuActions( FBlueprintActionDatabaseRegistrar& ActionRegistrar ) const
+{
+	CoreTechK2Utilities::DefaultGetMenuActions( this, ActionRegistrar );
+}
+
+#undef LOCTEXT_NAMESPACE
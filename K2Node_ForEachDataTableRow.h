@@ -0,0 +1,68 @@
+
+#pragma once
+
+#include "K2Node.h"
+
+#include "K2Node_ForEachDataTableRow.generated.h"
+
+UCLASS( )
+class CORETECHDEVELOPER_API UK2Node_ForEachDataTableRow : public UK2Node
+{
+	GENERATED_BODY( )
+public:
+
+	// Pin Accessors
+	UE_NODISCARD UEdGraphPin* GetDataTablePin( void ) const;
+	UE_NODISCARD UEdGraphPin* GetBreakPin( void ) const;
+
+	UE_NODISCARD UEdGraphPin* GetForEachPin( void ) const;
+	UE_NODISCARD UEdGraphPin* GetRowNamePin( void ) const;
+	UE_NODISCARD UEdGraphPin* GetRowPin( void ) const;
+	UE_NODISCARD UEdGraphPin* GetCompletedPin( void ) const;
+
+	// K2Node API
+	UE_NODISCARD bool IsNodeSafeToIgnore( ) const override { return true; }
+	void GetMenuActions( FBlueprintActionDatabaseRegistrar& ActionRegistrar ) const override;
+	UE_NODISCARD FText GetMenuCategory( ) const override;
+
+	// EdGraphNode API
+	void AllocateDefaultPins( ) override;
+	void ExpandNode( FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph ) override;
+	UE_NODISCARD FText GetNodeTitle( ENodeTitleType::Type TitleType ) const override;
+	UE_NODISCARD FText GetTooltipText( ) const override;
+	UE_NODISCARD FSlateIcon GetIconAndTint( FLinearColor& OutColor ) const override;
+	void PinConnectionListChanged( UEdGraphPin* Pin ) override;
+	void PinDefaultValueChanged( UEdGraphPin* Pin ) override;
+	bool ShouldShowNodeProperties( ) const override { return true; }
+	void ReallocatePinsDuringReconstruction( TArray< UEdGraphPin* > &OldPins ) override;
+
+	// Object API
+#if WITH_EDITOR
+	void PostEditChangeProperty( FPropertyChangedEvent &PropertyChangedEvent ) override;
+#endif
+
+private:
+	// Pin Names
+	static const FName DataTablePinName;
+	static const FName BreakPinName;
+	static const FName RowNamePinName;
+	static const FName RowPinName;
+	static const FName CompletedPinName;
+
+	// Determine if there is any configuration options that shouldn't be allowed
+	UE_NODISCARD bool CheckForErrors( const FKismetCompilerContext& CompilerContext );
+
+	// Determine the row type from the row struct, the data table or whatever the row is connected to
+	void RefreshRowType( );
+
+	// Update the row pin and its members
+	void SetRowType( const FEdGraphPinType &RowType );
+
+	// Whether the members of the row should be exposed as pins that read them in place, instead of copying the whole row
+	UPROPERTY( EditDefaultsOnly )
+	bool bReadRowByReference = false;
+
+	// The type of the rows, for tables that aren't known until the Blueprint runs. Takes priority over the type of a picked data table.
+	UPROPERTY( EditDefaultsOnly, meta = (MetaStruct = "/Script/Engine.TableRowBase") )
+	TObjectPtr< UScriptStruct > RowStruct;
+};
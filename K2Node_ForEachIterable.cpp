@@ -0,0 +1,337 @@
+
+#include "K2Nodes/K2Node_ForEachIterable.h"
+
+#include "CoreTechIterable.h"
+#include "CoreTechIterationLibrary.h"
+#include "CoreTechK2Utilities.h"
+
+// BlueprintGraph
+#include "K2Node_CallFunction.h"
+#include "K2Node_ExecutionSequence.h"
+#include "K2Node_IfThenElse.h"
+#include "K2Node_TemporaryVariable.h"
+
+// Engine
+#include "Engine/Blueprint.h"
+
+// KismetCompiler
+#include "KismetCompiler.h"
+
+#define LOCTEXT_NAMESPACE "K2Node_ForEachIterable"
+
+const FName UK2Node_ForEachIterable::ContainerPinName( TEXT( "ContainerPin" ) );
+const FName UK2Node_ForEachIterable::BreakPinName( TEXT( "BreakPin" ) );
+const FName UK2Node_ForEachIterable::ElementPinName( TEXT( "ElementPin" ) );
+const FName UK2Node_ForEachIterable::CompletedPinName( TEXT( "CompletedPin" ) );
+
+// Whether a class is an iterable container, or an interface that only iterable containers can implement
+static bool IsIterableClass( const UClass *ContainerClass )
+{
+	return (ContainerClass != nullptr) && (ContainerClass->IsChildOf( UCoreTechIterable::StaticClass( ) ) || ContainerClass->ImplementsInterface( UCoreTechIterable::StaticClass( ) ));
+}
+
+// Find the type of the elements declared by an iterable container class
+static bool GetIterableElementType( const UEdGraphSchema_K2 *K2Schema, const UClass *ContainerClass, FEdGraphPinType &OutElementType )
+{
+	if ((ContainerClass == nullptr) || !ContainerClass->ImplementsInterface( UCoreTechIterable::StaticClass( ) ))
+		return false;
+
+	// The element type is declared per class, so the default object can answer for every instance
+	const auto Iterable = Cast< ICoreTechIterable >( ContainerClass->GetDefaultObject( ) );
+	const auto ElementProperty = (Iterable != nullptr) ? Iterable->GetIterableElementProperty( ) : nullptr;
+	if (ElementProperty == nullptr)
+		return false;
+
+	return K2Schema->ConvertPropertyToPinType( ElementProperty, OutElementType );
+}
+
+void UK2Node_ForEachIterable::AllocateDefaultPins( )
+{
+	Super::AllocateDefaultPins( );
+
+	// Execution pin
+	CreatePin( EGPD_Input, UEdGraphSchema_K2::PC_Exec, UEdGraphSchema_K2::PN_Execute );
+
+	const auto ContainerPin = CreatePin( EGPD_Input, UEdGraphSchema_K2::PC_Object, UObject::StaticClass( ), ContainerPinName );
+	ContainerPin->PinFriendlyName = LOCTEXT( "ContainerPin_FriendlyName", "Container" );
+
+	const auto BreakPin = CreatePin( EGPD_Input, UEdGraphSchema_K2::PC_Exec, BreakPinName );
+	BreakPin->PinFriendlyName = LOCTEXT( "BreakPin_FriendlyName", "Break" );
+	BreakPin->bAdvancedView = true;
+
+	// For Each pin
+	const auto ForEachPin = CreatePin( EGPD_Output, UEdGraphSchema_K2::PC_Exec, UEdGraphSchema_K2::PN_Then );
+	ForEachPin->PinFriendlyName = LOCTEXT( "ForEachPin_FriendlyName", "Loop Body" );
+
+	const auto ElementPin = CreatePin( EGPD_Output, UEdGraphSchema_K2::PC_Wildcard, ElementPinName );
+	ElementPin->PinFriendlyName = LOCTEXT( "ElementPin_FriendlyName", "Element" );
+
+	const auto CompletedPin = CreatePin( EGPD_Output, UEdGraphSchema_K2::PC_Exec, CompletedPinName );
+	CompletedPin->PinFriendlyName = LOCTEXT( "CompletedPin_FriendlyName", "Completed" );
+	CompletedPin->PinToolTip = LOCTEXT( "CompletedPin_Tooltip", "Execution once all elements have been visited" ).ToString( );
+
+	CoreTechK2Utilities::SetPinToolTip( ContainerPin, LOCTEXT( "ContainerPin_Tooltip", "Iterable container to visit all elements of" ) );
+	CoreTechK2Utilities::SetPinToolTip( ElementPin, LOCTEXT( "ElementPin_Tooltip", "Element of the container" ) );
+
+	if (AdvancedPinDisplay == ENodeAdvancedPins::NoPins)
+		AdvancedPinDisplay = ENodeAdvancedPins::Hidden;
+}
+
+void UK2Node_ForEachIterable::PostReconstructNode( )
+{
+	Super::PostReconstructNode( );
+
+	// The container pin has its connections back now, so the element type can be determined again
+	RefreshElementPinType( );
+}
+
+void UK2Node_ForEachIterable::ExpandNode( FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph )
+{
+	Super::ExpandNode( CompilerContext, SourceGraph );
+
+	if (CheckForErrors( CompilerContext ))
+	{
+		// remove all the links to this node as they are no longer needed
+		BreakAllNodeLinks( );
+		return;
+	}
+
+	const auto K2Schema = CompilerContext.GetSchema( );
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// Cache off versions of all our important pins
+	const auto ExecPin = GetExecPin( );
+	const auto ContainerPin = GetContainerPin( );
+	const auto BreakPin = GetBreakPin( );
+
+	const auto ForEachPin = GetForEachPin( );
+	const auto ElementPin = GetElementPin( );
+	const auto CompletedPin = GetCompletedPin( );
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// Create the cursor variable
+	const auto CreateTemporaryVariable = CompilerContext.SpawnIntermediateNode< UK2Node_TemporaryVariable >( this, SourceGraph );
+	CreateTemporaryVariable->VariableType.PinCategory = UEdGraphSchema_K2::PC_Struct;
+	CreateTemporaryVariable->VariableType.PinSubCategoryObject = FCoreTechIterableCursor::StaticStruct( );
+	CreateTemporaryVariable->AllocateDefaultPins( );
+
+	const auto Temp_Variable = CreateTemporaryVariable->GetVariablePin( );
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// Point the cursor at the start of the container
+	const auto CallBegin = CompilerContext.SpawnIntermediateNode< UK2Node_CallFunction >( this, SourceGraph );
+	CallBegin->FunctionReference.SetExternalMember( GET_FUNCTION_NAME_CHECKED( UCoreTechIterationLibrary, IterableCursor_Begin ), UCoreTechIterationLibrary::StaticClass( ) );
+	CallBegin->AllocateDefaultPins( );
+
+	const auto Begin_Exec = CallBegin->GetExecPin( );
+	const auto Begin_Container = CallBegin->FindPinChecked( TEXT( "Container" ) );
+	const auto Begin_Cursor = CallBegin->FindPinChecked( TEXT( "Cursor" ) );
+	const auto Begin_Element = CallBegin->FindPinChecked( TEXT( "Element" ) );
+	const auto Begin_Then = CallBegin->GetThenPin( );
+
+	CompilerContext.MovePinLinksToIntermediate( *ExecPin, *Begin_Exec );
+	CompilerContext.MovePinLinksToIntermediate( *ContainerPin, *Begin_Container );
+	Temp_Variable->MakeLinkTo( Begin_Cursor );
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// Step to the next element, branching on whether there was one
+	const auto CallNext = CompilerContext.SpawnIntermediateNode< UK2Node_CallFunction >( this, SourceGraph );
+	CallNext->FunctionReference.SetExternalMember( GET_FUNCTION_NAME_CHECKED( UCoreTechIterationLibrary, IterableCursor_Next ), UCoreTechIterationLibrary::StaticClass( ) );
+	CallNext->AllocateDefaultPins( );
+
+	const auto Next_Exec = CallNext->GetExecPin( );
+	const auto Next_Cursor = CallNext->FindPinChecked( TEXT( "Cursor" ) );
+	const auto Next_Element = CallNext->FindPinChecked( TEXT( "Element" ) );
+	const auto Next_Return = CallNext->GetReturnValuePin( );
+	const auto Next_Then = CallNext->GetThenPin( );
+
+	// Coerce the wildcard pin types
+	Next_Element->PinType = ElementPin->PinType;
+
+	Begin_Then->MakeLinkTo( Next_Exec );
+	Temp_Variable->MakeLinkTo( Next_Cursor );
+	CompilerContext.MovePinLinksToIntermediate( *ElementPin, *Next_Element );
+
+	// Begin checks the container against the element type once, taking the type from the element that Next writes
+	Begin_Element->PinType = ElementPin->PinType;
+	Begin_Element->MakeLinkTo( Next_Element );
+
+	const auto BranchOnNext = CompilerContext.SpawnIntermediateNode< UK2Node_IfThenElse >( this, SourceGraph );
+	BranchOnNext->AllocateDefaultPins( );
+
+	const auto Branch_Exec = BranchOnNext->GetExecPin( );
+	const auto Branch_Input = BranchOnNext->GetConditionPin( );
+	const auto Branch_Then = BranchOnNext->GetThenPin( );
+	const auto Branch_Else = BranchOnNext->GetElsePin( );
+
+	Next_Then->MakeLinkTo( Branch_Exec );
+	Next_Return->MakeLinkTo( Branch_Input );
+	CompilerContext.MovePinLinksToIntermediate( *CompletedPin, *Branch_Else );
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// Sequence the loop body and stepping to the next element
+	const auto LoopSequence = CompilerContext.SpawnIntermediateNode< UK2Node_ExecutionSequence >( this, SourceGraph );
+	LoopSequence->AllocateDefaultPins( );
+
+	const auto Sequence_Exec = LoopSequence->GetExecPin( );
+	const auto Sequence_One = LoopSequence->GetThenPinGivenIndex( 0 );
+	const auto Sequence_Two = LoopSequence->GetThenPinGivenIndex( 1 );
+
+	Branch_Then->MakeLinkTo( Sequence_Exec );
+	CompilerContext.MovePinLinksToIntermediate( *ForEachPin, *Sequence_One );
+	Sequence_Two->MakeLinkTo( Next_Exec );
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// Break exhausts the cursor. The loop will then fail to find another element on the next run of SequenceTwo
+	// and terminate without ever visiting the remaining elements.
+	const auto CallEnd = CompilerContext.SpawnIntermediateNode< UK2Node_CallFunction >( this, SourceGraph );
+	CallEnd->FunctionReference.SetExternalMember( GET_FUNCTION_NAME_CHECKED( UCoreTechIterationLibrary, IterableCursor_End ), UCoreTechIterationLibrary::StaticClass( ) );
+	CallEnd->AllocateDefaultPins( );
+
+	CompilerContext.MovePinLinksToIntermediate( *BreakPin, *CallEnd->GetExecPin( ) );
+	K2Schema->TryCreateConnection( Temp_Variable, CallEnd->FindPinChecked( TEXT( "Cursor" ) ) );
+
+	///////////////////////////////////////////////////////////////////////////////////
+	//
+	BreakAllNodeLinks( );
+}
+
+bool UK2Node_ForEachIterable::CheckForErrors( const FKismetCompilerContext& CompilerContext )
+{
+	bool bError = false;
+
+	if (GetContainerPin( )->LinkedTo.Num( ) == 0)
+	{
+		CompilerContext.MessageLog.Error( *LOCTEXT( "MissingContainer_Error", "For Each (Iterable) node @@ must have a container to iterate." ).ToString( ), this );
+		bError = true;
+	}
+	else if (GetElementPin( )->PinType.PinCategory == UEdGraphSchema_K2::PC_Wildcard)
+	{
+		CompilerContext.MessageLog.Error( *LOCTEXT( "UnknownElement_Error", "For Each (Iterable) node @@ can't determine the element type, the container class must implement ICoreTechIterable and declare an element property (or the Element pin must be connected when the container is only known by interface)." ).ToString( ), this );
+		bError = true;
+	}
+
+	return bError;
+}
+
+bool UK2Node_ForEachIterable::IsConnectionDisallowed( const UEdGraphPin* MyPin, const UEdGraphPin* OtherPin, FString& OutReason ) const
+{
+	if (MyPin->PinName == ContainerPinName)
+	{
+		const auto &Category = OtherPin->PinType.PinCategory;
+		if (((Category != UEdGraphSchema_K2::PC_Object) && (Category != UEdGraphSchema_K2::PC_Interface)) || !IsIterableClass( GetContainerClass( OtherPin ) ))
+		{
+			OutReason = LOCTEXT( "NotIterable_Reason", "Only objects that implement the Core Tech Iterable interface can be iterated." ).ToString( );
+			return true;
+		}
+	}
+
+	return Super::IsConnectionDisallowed( MyPin, OtherPin, OutReason );
+}
+
+UClass* UK2Node_ForEachIterable::GetContainerClass( const UEdGraphPin *ContainerLink ) const
+{
+	if (ContainerLink == nullptr)
+		return nullptr;
+
+	if (ContainerLink->PinType.PinSubCategory == UEdGraphSchema_K2::PSC_Self)
+	{
+		const auto Blueprint = GetBlueprint( );
+		return (Blueprint != nullptr) ? Blueprint->SkeletonGeneratedClass : nullptr;
+	}
+
+	return Cast< UClass >( ContainerLink->PinType.PinSubCategoryObject.Get( ) );
+}
+
+void UK2Node_ForEachIterable::RefreshElementPinType( )
+{
+	const auto ContainerPin = GetContainerPin( );
+	const auto ElementPin = GetElementPin( );
+
+	FEdGraphPinType ElementType;
+	ElementType.PinCategory = UEdGraphSchema_K2::PC_Wildcard;
+
+	if (ContainerPin->LinkedTo.Num( ) > 0)
+	{
+		FEdGraphPinType DeclaredType;
+		if (GetIterableElementType( CastChecked< UEdGraphSchema_K2 >( GetSchema( ) ), GetContainerClass( ContainerPin->LinkedTo[ 0 ] ), DeclaredType ))
+		{
+			ElementType = DeclaredType;
+		}
+		else if (ElementPin->LinkedTo.Num( ) > 0)
+		{
+			// A container only known by interface doesn't declare its elements, so they're read as whatever the element is connected to
+			// and checked against the container when the loop starts
+			ElementType = ElementPin->LinkedTo[ 0 ]->PinType;
+			ElementType.bIsReference = false;
+		}
+	}
+
+	if (ElementPin->PinType == ElementType)
+		return;
+
+	ElementPin->PinType = ElementType;
+	CoreTechK2Utilities::SetPinToolTip( ElementPin, LOCTEXT( "ElementPin_Tooltip", "Element of the container" ) );
+
+	CoreTechK2Utilities::RefreshAllowedConnections( this, ElementPin );
+}
+
+void UK2Node_ForEachIterable::PinConnectionListChanged( UEdGraphPin* Pin )
+{
+	Super::PinConnectionListChanged( Pin );
+
+	if ((Pin != nullptr) && ((Pin->PinName == ContainerPinName) || (Pin->PinName == ElementPinName)))
+		RefreshElementPinType( );
+}
+
+UEdGraphPin* UK2Node_ForEachIterable::GetContainerPin( void ) const
+{
+	return FindPinChecked( ContainerPinName );
+}
+
+UEdGraphPin* UK2Node_ForEachIterable::GetBreakPin( void ) const
+{
+	return FindPinChecked( BreakPinName );
+}
+
+UEdGraphPin* UK2Node_ForEachIterable::GetForEachPin( void ) const
+{
+	return FindPinChecked( UEdGraphSchema_K2::PN_Then );
+}
+
+UEdGraphPin* UK2Node_ForEachIterable::GetElementPin( void ) const
+{
+	return FindPinChecked( ElementPinName );
+}
+
+UEdGraphPin* UK2Node_ForEachIterable::GetCompletedPin( void ) const
+{
+	return FindPinChecked( CompletedPinName );
+}
+
+FText UK2Node_ForEachIterable::GetNodeTitle( ENodeTitleType::Type TitleType ) const
+{
+	return LOCTEXT( "NodeTitle_NONE", "For Each (Iterable)" );
+}
+
+FText UK2Node_ForEachIterable::GetTooltipText( ) const
+{
+	return LOCTEXT( "NodeToolTip", "Loop over each element of a native container that implements ICoreTechIterable, reading the elements from the container in place instead of copying them into an array first" );
+}
+
+FText UK2Node_ForEachIterable::GetMenuCategory( ) const
+{
+	return LOCTEXT( "NodeMenu", "Core Utilities" );
+}
+
+FSlateIcon UK2Node_ForEachIterable::GetIconAndTint( FLinearColor& OutColor ) const
+{
+	return FSlateIcon( "EditorStyle", "GraphEditor.Macro.ForEach_16x" );
+}
+
+void UK2Node_ForEachIterable::GetMenuActions( FBlueprintActionDatabaseRegistrar& ActionRegistrar ) const
+{
+	CoreTechK2Utilities::DefaultGetMenuActions( this, ActionRegistrar );
+}
+
+#undef LOCTEXT_NAMESPACE
\ No newline at end of file
@@ -0,0 +1,52 @@
+
+#pragma once
+
+#include "K2Node.h"
+
+#include "K2Node_ForEachIterable.generated.h"
+
+UCLASS( )
+class CORETECHDEVELOPER_API UK2Node_ForEachIterable : public UK2Node
+{
+	GENERATED_BODY( )
+public:
+
+	// Pin Accessors
+	UE_NODISCARD UEdGraphPin* GetContainerPin( void ) const;
+	UE_NODISCARD UEdGraphPin* GetBreakPin( void ) const;
+
+	UE_NODISCARD UEdGraphPin* GetForEachPin( void ) const;
+	UE_NODISCARD UEdGraphPin* GetElementPin( void ) const;
+	UE_NODISCARD UEdGraphPin* GetCompletedPin( void ) const;
+
+	// K2Node API
+	UE_NODISCARD bool IsNodeSafeToIgnore( ) const override { return true; }
+	void GetMenuActions( FBlueprintActionDatabaseRegistrar& ActionRegistrar ) const override;
+	UE_NODISCARD FText GetMenuCategory( ) const override;
+	UE_NODISCARD bool IsConnectionDisallowed( const UEdGraphPin* MyPin, const UEdGraphPin* OtherPin, FString& OutReason ) const override;
+	void PostReconstructNode( ) override;
+
+	// EdGraphNode API
+	void AllocateDefaultPins( ) override;
+	void ExpandNode( FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph ) override;
+	UE_NODISCARD FText GetNodeTitle( ENodeTitleType::Type TitleType ) const override;
+	UE_NODISCARD FText GetTooltipText( ) const override;
+	UE_NODISCARD FSlateIcon GetIconAndTint( FLinearColor& OutColor ) const override;
+	void PinConnectionListChanged( UEdGraphPin* Pin ) override;
+
+private:
+	// Pin Names
+	static const FName ContainerPinName;
+	static const FName BreakPinName;
+	static const FName ElementPinName;
+	static const FName CompletedPinName;
+
+	// Determine if there is any configuration options that shouldn't be allowed
+	UE_NODISCARD bool CheckForErrors( const FKismetCompilerContext& CompilerContext );
+
+	// Find the class of the container connected to a pin, or null if it isn't known
+	UE_NODISCARD UClass* GetContainerClass( const UEdGraphPin *ContainerLink ) const;
+
+	// Update the element pin to match the elements declared by the container class
+	void RefreshElementPinType( );
+};
\ No newline at end of file
@@ -0,0 +1,192 @@
+
+#include "K2Nodes/K2Node_ForEachRemove.h"
+
+#include "CoreTechArrayLibrary.h"
+
+// BlueprintGraph
+#include "K2Node_CallFunction.h"
+#include "K2Node_Knot.h"
+#include "K2Node_TemporaryVariable.h"
+#include "K2Node_VariableGet.h"
+
+// Kismet
+#include "Kismet/KismetArrayLibrary.h"
+
+// KismetCompiler
+#include "KismetCompiler.h"
+
+// UnrealEd
+#include "Kismet2/BlueprintEditorUtils.h"
+
+#define LOCTEXT_NAMESPACE "K2Node_ForEachRemove"
+
+const FName UK2Node_ForEachRemove::RemovePinName( TEXT( "RemovePin" ) );
+
+// Find the node that the value of a linked input pin comes from, looking through any reroute nodes on the way
+static const UEdGraphNode* FindSourceNode( const UEdGraphPin *Pin )
+{
+	auto SourceNode = Pin->LinkedTo[ 0 ]->GetOwningNode( );
+	while (const auto Knot = Cast< UK2Node_Knot >( SourceNode ))
+	{
+		const auto KnotInput = Knot->GetInputPin( );
+		if (KnotInput->LinkedTo.Num( ) == 0)
+			break;
+
+		SourceNode = KnotInput->LinkedTo[ 0 ]->GetOwningNode( );
+	}
+
+	return SourceNode;
+}
+
+UK2Node_ForEachRemove::UK2Node_ForEachRemove( )
+{
+	// The removal adds to the loop body, so it's never shared with another loop
+	bCanFuseWithNextLoop = false;
+}
+
+void UK2Node_ForEachRemove::AllocateDefaultPins( )
+{
+	Super::AllocateDefaultPins( );
+
+	const auto RemovePin = CreatePin( EGPD_Input, UEdGraphSchema_K2::PC_Exec, RemovePinName );
+	RemovePin->PinFriendlyName = LOCTEXT( "RemovePin_FriendlyName", "Remove" );
+	RemovePin->PinToolTip = LOCTEXT( "RemovePin_Tooltip", "Remove the current element once the loop completes, finishing the loop body for this element" ).ToString( );
+}
+
+#if WITH_EDITOR
+void UK2Node_ForEachRemove::PostEditChangeProperty( FPropertyChangedEvent &PropertyChangedEvent )
+{
+	Super::PostEditChangeProperty( PropertyChangedEvent );
+
+	if (PropertyChangedEvent.GetPropertyName( ) == GET_MEMBER_NAME_CHECKED( UK2Node_ForEachRemove, bKeepOrder ))
+	{
+		// Poke the graph to update the visuals based on the above changes
+		GetGraph( )->NotifyGraphChanged( );
+		FBlueprintEditorUtils::MarkBlueprintAsModified( GetBlueprint( ) );
+	}
+}
+#endif
+
+void UK2Node_ForEachRemove::ExpandNode( FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph )
+{
+	if (CheckForRemoveErrors( CompilerContext ))
+	{
+		// remove all the links to this node as they are no longer needed
+		BreakAllNodeLinks( );
+		return;
+	}
+
+	const auto RemovePin = GetRemovePin( );
+
+	// Without anything to remove, this is only a regular loop
+	if (RemovePin->LinkedTo.Num( ) == 0)
+	{
+		Super::ExpandNode( CompilerContext, SourceGraph );
+		return;
+	}
+
+	// The removal is wired up to the pins of this node so that the loop expansion picks it up from there.
+	// Nothing is removed until the loop completes, so the element and index stay in step with the array throughout.
+	const auto ExecPin = GetExecPin( );
+	const auto ArrayPin = GetArrayPin( );
+	const auto ArrayIndexPin = GetArrayIndexPin( );
+	const auto CompletedPin = GetCompletedPin( );
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// Create the list of indices to remove
+	const auto CreateIndicesVariable = CompilerContext.SpawnIntermediateNode< UK2Node_TemporaryVariable >( this, SourceGraph );
+	CreateIndicesVariable->VariableType.PinCategory = UEdGraphSchema_K2::PC_Int;
+	CreateIndicesVariable->VariableType.ContainerType = EPinContainerType::Array;
+	CreateIndicesVariable->AllocateDefaultPins( );
+
+	const auto Temp_Indices = CreateIndicesVariable->GetVariablePin( );
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// Clear the list on entry to the loop
+	const auto ClearIndices = CompilerContext.SpawnIntermediateNode< UK2Node_CallFunction >( this, SourceGraph );
+	ClearIndices->FunctionReference.SetExternalMember( GET_FUNCTION_NAME_CHECKED( UKismetArrayLibrary, Array_Clear ), UKismetArrayLibrary::StaticClass( ) );
+	ClearIndices->AllocateDefaultPins( );
+
+	const auto Clear_Array = ClearIndices->FindPinChecked( TEXT( "TargetArray" ) );
+
+	// Coerce the wildcard pin types
+	Clear_Array->PinType = Temp_Indices->PinType;
+	Clear_Array->MakeLinkTo( Temp_Indices );
+
+	CompilerContext.MovePinLinksToIntermediate( *ExecPin, *ClearIndices->GetExecPin( ) );
+	ClearIndices->GetThenPin( )->MakeLinkTo( ExecPin );
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// Record the index of the current element from the remove pin. The loop visits the indices in order, so the list is always sorted.
+	const auto AddIndex = CompilerContext.SpawnIntermediateNode< UK2Node_CallFunction >( this, SourceGraph );
+	AddIndex->FunctionReference.SetExternalMember( GET_FUNCTION_NAME_CHECKED( UKismetArrayLibrary, Array_Add ), UKismetArrayLibrary::StaticClass( ) );
+	AddIndex->AllocateDefaultPins( );
+
+	const auto Add_Array = AddIndex->FindPinChecked( TEXT( "TargetArray" ) );
+	const auto Add_Item = AddIndex->FindPinChecked( TEXT( "NewItem" ) );
+
+	// Coerce the wildcard pin types
+	Add_Array->PinType = Temp_Indices->PinType;
+	Add_Item->PinType = ArrayIndexPin->PinType;
+
+	Add_Array->MakeLinkTo( Temp_Indices );
+	Add_Item->MakeLinkTo( ArrayIndexPin );
+	CompilerContext.MovePinLinksToIntermediate( *RemovePin, *AddIndex->GetExecPin( ) );
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// Remove all the recorded elements in a single pass once the loop completes
+	const auto RemoveIndices = CompilerContext.SpawnIntermediateNode< UK2Node_CallFunction >( this, SourceGraph );
+	RemoveIndices->FunctionReference.SetExternalMember( GET_FUNCTION_NAME_CHECKED( UCoreTechArrayLibrary, Array_RemoveIndices ), UCoreTechArrayLibrary::StaticClass( ) );
+	RemoveIndices->AllocateDefaultPins( );
+
+	const auto Remove_Exec = RemoveIndices->GetExecPin( );
+	const auto Remove_Array = RemoveIndices->FindPinChecked( TEXT( "TargetArray" ) );
+	const auto Remove_Indices = RemoveIndices->FindPinChecked( TEXT( "Indices" ) );
+	const auto Remove_KeepOrder = RemoveIndices->FindPinChecked( TEXT( "bKeepOrder" ) );
+	const auto Remove_Then = RemoveIndices->GetThenPin( );
+
+	// Coerce the wildcard pin types
+	Remove_Array->PinType = ArrayPin->PinType;
+
+	CompilerContext.CopyPinLinksToIntermediate( *ArrayPin, *Remove_Array );
+	Remove_Indices->MakeLinkTo( Temp_Indices );
+	Remove_KeepOrder->DefaultValue = bKeepOrder ? TEXT( "true" ) : TEXT( "false" );
+
+	CompilerContext.MovePinLinksToIntermediate( *CompletedPin, *Remove_Then );
+	CompletedPin->MakeLinkTo( Remove_Exec );
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// Expand the loop itself
+	Super::ExpandNode( CompilerContext, SourceGraph );
+}
+
+bool UK2Node_ForEachRemove::CheckForRemoveErrors( const FKismetCompilerContext& CompilerContext )
+{
+	const auto ArrayPin = GetArrayPin( );
+	if ((GetRemovePin( )->LinkedTo.Num( ) > 0) && (ArrayPin->LinkedTo.Num( ) > 0) && (Cast< UK2Node_VariableGet >( FindSourceNode( ArrayPin ) ) == nullptr))
+	{
+		CompilerContext.MessageLog.Warning( *LOCTEXT( "NotVariable_Warning", "For Each With Remove node @@ isn't looping over an array variable, elements may only be removed from a copy of the array." ).ToString( ), this );
+	}
+
+	return false;
+}
+
+UEdGraphPin* UK2Node_ForEachRemove::GetRemovePin( void ) const
+{
+	return FindPinChecked( RemovePinName );
+}
+
+FText UK2Node_ForEachRemove::GetNodeTitle( ENodeTitleType::Type TitleType ) const
+{
+	return LOCTEXT( "NodeTitle_NONE", "For Each Loop With Remove (Native)" );
+}
+
+FText UK2Node_ForEachRemove::GetTooltipText( ) const
+{
+	if (!bKeepOrder)
+		return LOCTEXT( "NodeToolTip_Swap", "Loop over each element of an array, removing the elements that the loop body runs Remove for once the loop completes. The gaps are filled from the end of the array, so the remaining elements don't keep their order." );
+
+	return LOCTEXT( "NodeToolTip", "Loop over each element of an array, removing the elements that the loop body runs Remove for in a single pass once the loop completes" );
+}
+
+#undef LOCTEXT_NAMESPACE
\ No newline at end of file
@@ -0,0 +1,39 @@
+
+#pragma once
+
+#include "K2Nodes/K2Node_NativeForEach.h"
+
+#include "K2Node_ForEachRemove.generated.h"
+
+UCLASS( )
+class CORETECHDEVELOPER_API UK2Node_ForEachRemove : public UK2Node_NativeForEach
+{
+	GENERATED_BODY( )
+public:
+	UK2Node_ForEachRemove( );
+
+	// Pin Accessors
+	UE_NODISCARD UEdGraphPin* GetRemovePin( void ) const;
+
+	// EdGraphNode API
+	void AllocateDefaultPins( ) override;
+	void ExpandNode( FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph ) override;
+	UE_NODISCARD FText GetNodeTitle( ENodeTitleType::Type TitleType ) const override;
+	UE_NODISCARD FText GetTooltipText( ) const override;
+
+	// Object API
+#if WITH_EDITOR
+	void PostEditChangeProperty( FPropertyChangedEvent &PropertyChangedEvent ) override;
+#endif
+
+private:
+	// Pin Names
+	static const FName RemovePinName;
+
+	// Determine if there is any configuration options that shouldn't be allowed
+	UE_NODISCARD bool CheckForRemoveErrors( const FKismetCompilerContext& CompilerContext );
+
+	// Whether the elements left after removal should stay in the same order, instead of the gaps being filled from the end of the array
+	UPROPERTY( EditDefaultsOnly )
+	bool bKeepOrder = true;
+};
\ No newline at end of file
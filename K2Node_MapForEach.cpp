@@ -3,13 +3,19 @@
 
 #include "K2Nodes/K2Node_NativeForEach.h"
 
+#include "CoreTechArrayLibrary.h"
+#include "CoreTechK2NodesVersion.h"
 #include "CoreTechK2Utilities.h"
 
 // KismetCompiler
 #include "KismetCompiler.h"
 
 // BlueprintGraph
+#include "K2Node_AssignmentStatement.h"
 #include "K2Node_CallFunction.h"
+#include "K2Node_ExecutionSequence.h"
+#include "K2Node_IfThenElse.h"
+#include "K2Node_TemporaryVariable.h"
 
 // UnrealEd
 #include "Kismet2/BlueprintEditorUtils.h"
@@ -25,6 +31,18 @@ const FName UK2Node_MapForEach::KeyPinName( TEXT( "KeyPin" ) );
 const FName UK2Node_MapForEach::ValuePinName( TEXT( "ValuePin" ) );
 const FName UK2Node_MapForEach::CompletedPinName( TEXT( "CompletedPin" ) );
 
+static FEdGraphPinType GetWildcardMapType( )
+{
+	FEdGraphPinType PinType;
+	PinType.PinCategory = UEdGraphSchema_K2::PC_Wildcard;
+	PinType.ContainerType = EPinContainerType::Map;
+	PinType.PinValueType.TerminalCategory = UEdGraphSchema_K2::PC_Wildcard;
+	PinType.bIsConst = true;
+	PinType.bIsReference = true;
+
+	return PinType;
+}
+
 UK2Node_MapForEach::UK2Node_MapForEach( )
 {
 	KeyName = LOCTEXT( "KeyPin_FriendlyName", "Map Key" ).ToString( );
@@ -38,13 +56,7 @@ void UK2Node_MapForEach::AllocateDefaultPins( )
 	// Execution pin
 	CreatePin( EGPD_Input, UEdGraphSchema_K2::PC_Exec, UEdGraphSchema_K2::PN_Execute );
 
-	UEdGraphNode::FCreatePinParams PinParams;
-	PinParams.ContainerType = EPinContainerType::Map;
-	PinParams.ValueTerminalType.TerminalCategory = UEdGraphSchema_K2::PC_Wildcard;
-
-	const auto MapPin = CreatePin( EGPD_Input, UEdGraphSchema_K2::PC_Wildcard, MapPinName, PinParams );
-	MapPin->PinType.bIsConst = true;
-	MapPin->PinType.bIsReference = true;
+	const auto MapPin = CreatePin( EGPD_Input, GetWildcardMapType( ), MapPinName );
 	MapPin->PinFriendlyName = LOCTEXT( "MapPin_FriendlyName", "Map" );
 
 	const auto BreakPin = CreatePin( EGPD_Input, UEdGraphSchema_K2::PC_Exec, BreakPinName );
@@ -65,24 +77,6 @@ void UK2Node_MapForEach::AllocateDefaultPins( )
 	CompletedPin->PinFriendlyName = LOCTEXT( "CompletedPin_FriendlyName", "Completed" );
 	CompletedPin->PinToolTip = LOCTEXT( "CompletedPin_Tooltip", "Execution once all array elements have been visited" ).ToString( );
 
-	if (bOneTimeInit)
-	{
-		InputWildcardType = MapPin->PinType;
-		OutputWildcardType = ValuePin->PinType;
-
-		InputCurrentType = MapPin->PinType;
-		KeyCurrentType = KeyPin->PinType;
-		ValueCurrentType = ValuePin->PinType;
-
-		bOneTimeInit = false;
-	}
-	else
-	{
-		MapPin->PinType = InputCurrentType;
-		KeyPin->PinType = KeyCurrentType;
-		ValuePin->PinType = ValueCurrentType;
-	}
-
 	CoreTechK2Utilities::SetPinToolTip( MapPin, LOCTEXT( "MapPin_Tooltip", "Map to visit all elements of" ) );
 	CoreTechK2Utilities::SetPinToolTip( KeyPin, LOCTEXT( "KeyPin_Tooltip", "Key of Value into Map" ) );
 	CoreTechK2Utilities::SetPinToolTip( ValuePin, LOCTEXT( "ValuePin_Tooltip", "Value of the Map" ) );
@@ -91,18 +85,45 @@ void UK2Node_MapForEach::AllocateDefaultPins( )
 		AdvancedPinDisplay = ENodeAdvancedPins::Hidden;
 }
 
+void UK2Node_MapForEach::ReallocatePinsDuringReconstruction( TArray< UEdGraphPin* > &OldPins )
+{
+	Super::ReallocatePinsDuringReconstruction( OldPins );
+
+	if (const auto OldMapType = CoreTechK2Utilities::GetReconstructedPinType( OldPins, MapPinName ))
+		SetMapType( *OldMapType );
+}
+
 void UK2Node_MapForEach::PostPasteNode( )
 {
 	Super::PostPasteNode( );
 
-	if (const auto MapPin = GetMapPin( ))
-	{
-		if (MapPin->LinkedTo.Num( ) == 0)
-			bOneTimeInit = true;
-	}
-	else
+	if (CoreTechK2Utilities::IsPinTypeStale( GetMapPin( ) ))
+		PinConnectionListChanged( GetMapPin( ) );
+}
+
+void UK2Node_MapForEach::Serialize( FArchive &Ar )
+{
+	Super::Serialize( Ar );
+
+	Ar.UsingCustomVersion( FCoreTechK2NodesVersion::GUID );
+}
+
+void UK2Node_MapForEach::PostLoad( )
+{
+	Super::PostLoad( );
+
+	if (GetLinkerCustomVersion( FCoreTechK2NodesVersion::GUID ) < FCoreTechK2NodesVersion::CompactWildcardPinTypes)
 	{
-		bOneTimeInit = true;
+		// The saved type was the authority for older nodes, make sure the pins agree with it before discarding it
+		const auto MapPin = FindPin( MapPinName );
+		if ((MapPin != nullptr) && (MapPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Wildcard) &&
+			(InputCurrentType.PinCategory != NAME_None) && (InputCurrentType.PinCategory != UEdGraphSchema_K2::PC_Wildcard))
+		{
+			SetMapType( InputCurrentType );
+		}
+
+		// Back to the default value so that it's no longer written out
+		InputCurrentType = FEdGraphPinType( );
 	}
 }
 
@@ -123,6 +144,11 @@ void UK2Node_MapForEach::PostEditChangeProperty( FPropertyChangedEvent &Property
 		GetValuePin( )->PinFriendlyName = FText::FromString( ValueName );
 		bRefresh = true;
 	}
+	else if (PropertyChangedEvent.GetPropertyName( ) == GET_MEMBER_NAME_CHECKED( UK2Node_MapForEach, bProjectStructMembers ))
+	{
+		CoreTechK2Utilities::RefreshStructMemberPins( this, GetValuePin( ), bProjectStructMembers );
+		bRefresh = true;
+	}
 
 	if (bRefresh)
 	{
@@ -144,7 +170,14 @@ void UK2Node_MapForEach::ExpandNode( FKismetCompilerContext& CompilerContext, UE
 		return;
 	}
 
-	const auto K2Schema = GetDefault<UEdGraphSchema_K2>( );
+	// Projected members are read from the map storage, which means walking the storage instead of a copy of the keys
+	if (bProjectStructMembers && (CoreTechK2Utilities::GetPinTypeStruct( GetValuePin( )->PinType ) != nullptr))
+	{
+		ExpandSlotLoop( CompilerContext, SourceGraph );
+		return;
+	}
+
+	const auto K2Schema = CompilerContext.GetSchema( );
 
 	///////////////////////////////////////////////////////////////////////////////////
 	// Cache off versions of all our important pins
@@ -219,6 +252,174 @@ void UK2Node_MapForEach::ExpandNode( FKismetCompilerContext& CompilerContext, UE
 	BreakAllNodeLinks( );
 }
 
+void UK2Node_MapForEach::ExpandSlotLoop( FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph )
+{
+	const auto K2Schema = CompilerContext.GetSchema( );
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// Cache off versions of all our important pins
+	const auto ForEach_Exec = GetExecPin( );
+	const auto ForEach_Map = GetMapPin( );
+	const auto ForEach_Break = GetBreakPin( );
+
+	const auto ForEach_ForEach = GetForEachPin( );
+	const auto ForEach_Key = GetKeyPin( );
+	const auto ForEach_Value = GetValuePin( );
+	const auto ForEach_Completed = GetCompletedPin( );
+
+	// Every call into the library needs its own link to the map
+	const auto LinkMap = [ &CompilerContext, ForEach_Map ]( UK2Node_CallFunction *CallFunction )
+	{
+		const auto Call_Map = CallFunction->FindPinChecked( TEXT( "TargetMap" ) );
+		CompilerContext.CopyPinLinksToIntermediate( *ForEach_Map, *Call_Map );
+		CallFunction->PinConnectionListChanged( Call_Map );
+	};
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// Create a slot variable, an index into the element storage of the map
+	const auto CreateTemporaryVariable = CompilerContext.SpawnIntermediateNode< UK2Node_TemporaryVariable >( this, SourceGraph );
+	CreateTemporaryVariable->VariableType.PinCategory = UEdGraphSchema_K2::PC_Int;
+	CreateTemporaryVariable->AllocateDefaultPins( );
+
+	const auto Temp_Variable = CreateTemporaryVariable->GetVariablePin( );
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// Initialize the slot to before the first element
+	const auto InitTemporaryVariable = CompilerContext.SpawnIntermediateNode< UK2Node_AssignmentStatement >( this, SourceGraph );
+	InitTemporaryVariable->AllocateDefaultPins( );
+
+	const auto Init_Exec = InitTemporaryVariable->GetExecPin( );
+	const auto Init_Variable = InitTemporaryVariable->GetVariablePin( );
+	const auto Init_Value = InitTemporaryVariable->GetValuePin( );
+	const auto Init_Then = InitTemporaryVariable->GetThenPin( );
+
+	CompilerContext.MovePinLinksToIntermediate( *ForEach_Exec, *Init_Exec );
+	K2Schema->TryCreateConnection( Init_Variable, Temp_Variable );
+	Init_Value->DefaultValue = LexToString( INDEX_NONE );
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// Step to the next element, branching on whether there was one
+	const auto CallNext = CompilerContext.SpawnIntermediateNode< UK2Node_CallFunction >( this, SourceGraph );
+	CallNext->FunctionReference.SetExternalMember( GET_FUNCTION_NAME_CHECKED( UCoreTechArrayLibrary, Map_NextSlot ), UCoreTechArrayLibrary::StaticClass( ) );
+	CallNext->AllocateDefaultPins( );
+
+	const auto Next_Exec = CallNext->GetExecPin( );
+	const auto Next_Slot = CallNext->FindPinChecked( TEXT( "Slot" ) );
+	const auto Next_Return = CallNext->GetReturnValuePin( );
+	const auto Next_Then = CallNext->GetThenPin( );
+
+	Init_Then->MakeLinkTo( Next_Exec );
+	LinkMap( CallNext );
+	Temp_Variable->MakeLinkTo( Next_Slot );
+
+	const auto BranchOnNext = CompilerContext.SpawnIntermediateNode< UK2Node_IfThenElse >( this, SourceGraph );
+	BranchOnNext->AllocateDefaultPins( );
+
+	const auto Branch_Exec = BranchOnNext->GetExecPin( );
+	const auto Branch_Input = BranchOnNext->GetConditionPin( );
+	const auto Branch_Then = BranchOnNext->GetThenPin( );
+	const auto Branch_Else = BranchOnNext->GetElsePin( );
+
+	Next_Then->MakeLinkTo( Branch_Exec );
+	Next_Return->MakeLinkTo( Branch_Input );
+	CompilerContext.MovePinLinksToIntermediate( *ForEach_Completed, *Branch_Else );
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// Sequence the loop body and stepping to the next element
+	const auto LoopSequence = CompilerContext.SpawnIntermediateNode< UK2Node_ExecutionSequence >( this, SourceGraph );
+	LoopSequence->AllocateDefaultPins( );
+
+	const auto Sequence_Exec = LoopSequence->GetExecPin( );
+	const auto Sequence_One = LoopSequence->GetThenPinGivenIndex( 0 );
+	const auto Sequence_Two = LoopSequence->GetThenPinGivenIndex( 1 );
+
+	Branch_Then->MakeLinkTo( Sequence_Exec );
+	CompilerContext.MovePinLinksToIntermediate( *ForEach_ForEach, *Sequence_One );
+	Sequence_Two->MakeLinkTo( Next_Exec );
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// Only copy the key and the whole value if something actually wants them
+	if (ForEach_Key->LinkedTo.Num( ) > 0)
+	{
+		const auto CallGetKey = CompilerContext.SpawnIntermediateNode< UK2Node_CallFunction >( this, SourceGraph );
+		CallGetKey->FunctionReference.SetExternalMember( GET_FUNCTION_NAME_CHECKED( UCoreTechArrayLibrary, Map_GetSlotKey ), UCoreTechArrayLibrary::StaticClass( ) );
+		CallGetKey->AllocateDefaultPins( );
+
+		const auto GetKey_Slot = CallGetKey->FindPinChecked( TEXT( "Slot" ) );
+		const auto GetKey_Key = CallGetKey->FindPinChecked( TEXT( "Key" ) );
+
+		LinkMap( CallGetKey );
+
+		// Coerce the wildcard pin type
+		GetKey_Key->PinType = ForEach_Key->PinType;
+
+		Temp_Variable->MakeLinkTo( GetKey_Slot );
+		CompilerContext.MovePinLinksToIntermediate( *ForEach_Key, *GetKey_Key );
+	}
+
+	if (ForEach_Value->LinkedTo.Num( ) > 0)
+	{
+		const auto CallGetValue = CompilerContext.SpawnIntermediateNode< UK2Node_CallFunction >( this, SourceGraph );
+		CallGetValue->FunctionReference.SetExternalMember( GET_FUNCTION_NAME_CHECKED( UCoreTechArrayLibrary, Map_GetSlotValue ), UCoreTechArrayLibrary::StaticClass( ) );
+		CallGetValue->AllocateDefaultPins( );
+
+		const auto GetValue_Slot = CallGetValue->FindPinChecked( TEXT( "Slot" ) );
+		const auto GetValue_Value = CallGetValue->FindPinChecked( TEXT( "Value" ) );
+
+		LinkMap( CallGetValue );
+
+		// Coerce the wildcard pin type
+		GetValue_Value->PinType = ForEach_Value->PinType;
+
+		Temp_Variable->MakeLinkTo( GetValue_Slot );
+		CompilerContext.MovePinLinksToIntermediate( *ForEach_Value, *GetValue_Value );
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// Read any projected struct members directly out of the map storage
+	for (const auto Member : CoreTechK2Utilities::GetProjectableStructMembers( K2Schema, CoreTechK2Utilities::GetPinTypeStruct( ForEach_Value->PinType ) ))
+	{
+		const auto MemberPin = FindPin( CoreTechK2Utilities::GetStructMemberPinName( ValuePinName, Member ) );
+		if ((MemberPin == nullptr) || (MemberPin->LinkedTo.Num( ) == 0))
+			continue;
+
+		const auto GetMember = CompilerContext.SpawnIntermediateNode< UK2Node_CallFunction >( this, SourceGraph );
+		GetMember->FunctionReference.SetExternalMember( GET_FUNCTION_NAME_CHECKED( UCoreTechArrayLibrary, Map_GetSlotMember ), UCoreTechArrayLibrary::StaticClass( ) );
+		GetMember->AllocateDefaultPins( );
+
+		const auto GetMember_Slot = GetMember->FindPinChecked( TEXT( "Slot" ) );
+		const auto GetMember_Name = GetMember->FindPinChecked( TEXT( "MemberName" ) );
+		const auto GetMember_Value = GetMember->FindPinChecked( TEXT( "Value" ) );
+
+		LinkMap( GetMember );
+
+		// Coerce the wildcard pin type
+		GetMember_Value->PinType = MemberPin->PinType;
+
+		Temp_Variable->MakeLinkTo( GetMember_Slot );
+		GetMember_Name->DefaultValue = Member->GetName( );
+		CompilerContext.MovePinLinksToIntermediate( *MemberPin, *GetMember_Value );
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// Break moves the slot past the end of the map storage. The loop will then fail to find another element
+	// on the next run of SequenceTwo and terminate.
+	const auto SetVariable = CompilerContext.SpawnIntermediateNode< UK2Node_AssignmentStatement >( this, SourceGraph );
+	SetVariable->AllocateDefaultPins( );
+
+	const auto Set_Exec = SetVariable->GetExecPin( );
+	const auto Set_Variable = SetVariable->GetVariablePin( );
+	const auto Set_Value = SetVariable->GetValuePin( );
+
+	CompilerContext.MovePinLinksToIntermediate( *ForEach_Break, *Set_Exec );
+	K2Schema->TryCreateConnection( Temp_Variable, Set_Variable );
+	Set_Value->DefaultValue = LexToString( MAX_int32 );
+
+	///////////////////////////////////////////////////////////////////////////////////
+	//
+	BreakAllNodeLinks( );
+}
+
 bool UK2Node_MapForEach::CheckForErrors( const FKismetCompilerContext& CompilerContext )
 {
 	bool bError = false;
@@ -241,37 +442,42 @@ void UK2Node_MapForEach::PinConnectionListChanged( UEdGraphPin* Pin )
 
 	if (Pin->PinName == MapPinName)
 	{
-		const auto ValuePin = GetValuePin( );
-		const auto KeyPin = GetKeyPin( );
-
 		if (Pin->LinkedTo.Num( ) > 0)
-		{
-			const auto LinkedPin = Pin->LinkedTo[ 0 ];
+			SetMapType( Pin->LinkedTo[ 0 ]->PinType );
+		else
+			SetMapType( GetWildcardMapType( ) );
 
-			Pin->PinType = LinkedPin->PinType;
+		CoreTechK2Utilities::RefreshAllowedConnections( this, GetKeyPin( ) );
+		CoreTechK2Utilities::RefreshAllowedConnections( this, GetValuePin( ) );
+	}
+}
 
-			KeyPin->PinType = FEdGraphPinType::GetTerminalTypeForContainer( LinkedPin->PinType );
+void UK2Node_MapForEach::SetMapType( const FEdGraphPinType &MapType )
+{
+	const auto MapPin = GetMapPin( );
+	const auto KeyPin = GetKeyPin( );
+	const auto ValuePin = GetValuePin( );
 
-			ValuePin->PinType = FEdGraphPinType::GetPinTypeForTerminalType( LinkedPin->PinType.PinValueType );
-		}
-		else
-		{
-			Pin->PinType = InputWildcardType;
+	MapPin->PinType = MapType;
 
-			KeyPin->PinType = ValuePin->PinType = OutputWildcardType;
-		}
+	if (MapType.PinCategory != UEdGraphSchema_K2::PC_Wildcard)
+	{
+		KeyPin->PinType = FEdGraphPinType::GetTerminalTypeForContainer( MapType );
+		ValuePin->PinType = FEdGraphPinType::GetPinTypeForTerminalType( MapType.PinValueType );
+	}
+	else
+	{
+		FEdGraphPinType WildcardType;
+		WildcardType.PinCategory = UEdGraphSchema_K2::PC_Wildcard;
 
-		InputCurrentType = Pin->PinType;
-		KeyCurrentType = KeyPin->PinType;
-		ValueCurrentType = ValuePin->PinType;
+		KeyPin->PinType = ValuePin->PinType = WildcardType;
+	}
 
-		CoreTechK2Utilities::RefreshAllowedConnections( this, KeyPin );
-		CoreTechK2Utilities::RefreshAllowedConnections( this, ValuePin );
+	CoreTechK2Utilities::SetPinToolTip( MapPin, LOCTEXT( "MapPin_Tooltip", "Map to visit all elements of" ) );
+	CoreTechK2Utilities::SetPinToolTip( KeyPin, LOCTEXT( "KeyPin_Tooltip", "Key of Value into Map" ) );
+	CoreTechK2Utilities::SetPinToolTip( ValuePin, LOCTEXT( "ValuePin_Tooltip", "Value of the Map" ) );
 
-		CoreTechK2Utilities::SetPinToolTip( Pin, LOCTEXT( "MapPin_Tooltip", "Map to visit all elements of" ) );
-		CoreTechK2Utilities::SetPinToolTip( KeyPin, LOCTEXT( "KeyPin_Tooltip", "Key of Value into Map" ) );
-		CoreTechK2Utilities::SetPinToolTip( ValuePin, LOCTEXT( "ValuePin_Tooltip", "Value of the Map" ) );
-	}
+	CoreTechK2Utilities::RefreshStructMemberPins( this, ValuePin, bProjectStructMembers );
 }
 
 UEdGraphPin* UK2Node_MapForEach::GetMapPin( void ) const
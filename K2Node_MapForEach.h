@@ -38,8 +38,11 @@ public:
 	void PinConnectionListChanged( UEdGraphPin* Pin ) override;
 	bool ShouldShowNodeProperties( ) const override { return true; }
 	void PostPasteNode( ) override;
+	void ReallocatePinsDuringReconstruction( TArray< UEdGraphPin* > &OldPins ) override;
 
 	// Object API
+	void Serialize( FArchive &Ar ) override;
+	void PostLoad( ) override;
 #if WITH_EDITOR
 	void PostEditChangeProperty( FPropertyChangedEvent &PropertyChangedEvent ) override;
 #endif
@@ -55,30 +58,17 @@ private:
 	// Determine if there is any configuration options that shouldn't be allowed
 	UE_NODISCARD bool CheckForErrors( const FKismetCompilerContext& CompilerContext );
 
-	// Memory of what the input pin type is when it's a wildcard
-	UPROPERTY( )
-	FEdGraphPinType InputWildcardType;
+	// Expand into a loop over the slots of the map storage, reading the key, value and members in place
+	void ExpandSlotLoop( FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph );
 
-	// Memory of what the output pin type is when it's a wildcard
-	UPROPERTY( )
-	FEdGraphPinType OutputWildcardType;
+	// Update the types of the map, key and value pins
+	void SetMapType( const FEdGraphPinType &MapType );
 
-	// Memory of what the input pin type currently is
+	// Memory of the map type from before CompactWildcardPinTypes, only read when upgrading older nodes
+	// (the key and value types were always derived from it)
 	UPROPERTY( )
 	FEdGraphPinType InputCurrentType;
 
-	// Memory of what the key pin type currently is
-	UPROPERTY( )
-	FEdGraphPinType KeyCurrentType;
-
-	// Memory of what the value pin type currently is
-	UPROPERTY( )
-	FEdGraphPinType ValueCurrentType;
-
-	// Whether or not AllocateDefaultPins should fill out the wildcard types, or assign from the current types
-	UPROPERTY( )
-	bool bOneTimeInit = true;
-
 	// A user editable hook for the display name of the key pin
 	UPROPERTY( EditDefaultsOnly )
 	FString KeyName;
@@ -86,4 +76,9 @@ private:
 	// A user editable hook for the display name of the value pin
 	UPROPERTY( EditDefaultsOnly )
 	FString ValueName;
+
+	// Whether struct values should have a pin for each member that reads it directly from the map.
+	// The loop then walks the map storage in place instead of a copy of the keys, so elements added by the loop body may or may not be visited.
+	UPROPERTY( EditDefaultsOnly )
+	bool bProjectStructMembers = false;
 };
\ No newline at end of file
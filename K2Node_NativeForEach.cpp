@@ -1,14 +1,23 @@
 
 #include "K2Nodes/K2Node_NativeForEach.h"
 
+#include "CoreTechArrayLibrary.h"
+#include "CoreTechK2NodesVersion.h"
 #include "CoreTechK2Utilities.h"
 
 // BlueprintGraph
 #include "K2Node_AssignmentStatement.h"
+#include "K2Node_BreakStruct.h"
 #include "K2Node_CallFunction.h"
 #include "K2Node_ExecutionSequence.h"
+#include "K2Node_GetArrayItem.h"
 #include "K2Node_IfThenElse.h"
+#include "K2Node_Knot.h"
+#include "K2Node_MakeStruct.h"
+#include "K2Node_Self.h"
 #include "K2Node_TemporaryVariable.h"
+#include "K2Node_VariableGet.h"
+#include "K2Node_VariableSet.h"
 
 // Kismet
 #include "Kismet/KismetArrayLibrary.h"
@@ -17,6 +26,9 @@
 // KismetCompiler
 #include "KismetCompiler.h"
 
+// UnrealEd
+#include "Kismet2/BlueprintEditorUtils.h"
+
 #define LOCTEXT_NAMESPACE "K2Node_NativeForEach"
 
 const FName UK2Node_NativeForEach::ArrayPinName( TEXT( "ArrayPin" ) );
@@ -25,6 +37,161 @@ const FName UK2Node_NativeForEach::ElementPinName( TEXT( "ElementPin" ) );
 const FName UK2Node_NativeForEach::ArrayIndexPinName( TEXT( "ArrayIndexPin" ) );
 const FName UK2Node_NativeForEach::CompletedPinName( TEXT( "CompletedPin" ) );
 
+// How the loops of a graph being compiled share passes over their arrays
+struct FLoopFusionPlan
+{
+	// The loops fused into each loop that makes a shared pass, in the order that their bodies run
+	TMap< const UK2Node_NativeForEach*, TArray< UK2Node_NativeForEach* > > FusedLoops;
+
+	// Every loop that is expanded as part of the pass made by an earlier loop
+	TSet< const UK2Node_NativeForEach* > FusedIntoPrevious;
+
+	// Why each loop that asked to be fused with the next one wasn't
+	TMap< const UK2Node_NativeForEach*, FText > SkippedReasons;
+};
+
+// The plans for the graphs being compiled, keyed by the graph being expanded
+static TMap< TWeakObjectPtr< const UEdGraph >, FLoopFusionPlan > LoopFusionPlans;
+
+// The member and local variables that the nodes run by a loop body read and write
+struct FLoopBodyAccess
+{
+	TSet< FName > Reads;
+	TSet< FName > Writes;
+
+	// Every node that the loop body runs, and every node that provides a value to them
+	TSet< const UEdGraphNode* > Nodes;
+	TSet< const UEdGraphNode* > Sources;
+
+	// The first node used by the loop body that may read or change state beyond the variables above, null if there isn't one
+	const UEdGraphNode *Opaque = nullptr;
+};
+
+// Whether the only effects of running a node are the variable writes that are recorded for it
+static bool IsKnownLoopBodyNode( const UEdGraphNode *Node )
+{
+	return Node->IsA< UK2Node_VariableSet >( ) || Node->IsA< UK2Node_IfThenElse >( ) ||
+		Node->IsA< UK2Node_ExecutionSequence >( ) || Node->IsA< UK2Node_Knot >( );
+}
+
+// Whether a pure node only computes its outputs from its inputs (and the variables that are recorded for it).
+// Any other pure node, such as a pure Blueprint function or a getter, may read state that isn't tracked here.
+static bool IsKnownPureNode( const UK2Node *Node )
+{
+	if (Node->IsA< UK2Node_VariableGet >( ) || Node->IsA< UK2Node_Knot >( ) || Node->IsA< UK2Node_Self >( ) ||
+		Node->IsA< UK2Node_MakeStruct >( ) || Node->IsA< UK2Node_BreakStruct >( ) || Node->IsA< UK2Node_GetArrayItem >( ))
+	{
+		return true;
+	}
+
+	// Math operators (including the promotable ones) are calls into the math library
+	const auto CallFunction = Cast< UK2Node_CallFunction >( Node );
+	const auto Function = (CallFunction != nullptr) ? CallFunction->GetTargetFunction( ) : nullptr;
+	return (Function != nullptr) && (Function->GetOwnerClass( ) == UKismetMathLibrary::StaticClass( ));
+}
+
+// Record the variables that feed a node's inputs, following through any pure nodes that they pass through on the way
+static void GatherInputAccess( const UEdGraphNode *Node, FLoopBodyAccess &Access, TSet< const UEdGraphNode* > &Visited )
+{
+	for (const auto Pin : Node->Pins)
+	{
+		if ((Pin->Direction != EGPD_Input) || (Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec))
+			continue;
+
+		for (const auto LinkedPin : Pin->LinkedTo)
+		{
+			const auto LinkedNode = LinkedPin->GetOwningNode( );
+			Access.Sources.Add( LinkedNode );
+
+			if (const auto VariableGet = Cast< UK2Node_VariableGet >( LinkedNode ))
+			{
+				Access.Reads.Add( VariableGet->GetVarName( ) );
+
+				// Passing a variable by reference lets the node change it
+				if (Pin->PinType.bIsReference && !Pin->PinType.bIsConst)
+					Access.Writes.Add( VariableGet->GetVarName( ) );
+			}
+
+			const auto LinkedK2Node = Cast< UK2Node >( LinkedNode );
+			if ((LinkedK2Node != nullptr) && LinkedK2Node->IsNodePure( ) && !Visited.Contains( LinkedK2Node ))
+			{
+				Visited.Add( LinkedK2Node );
+
+				if ((Access.Opaque == nullptr) && !IsKnownPureNode( LinkedK2Node ))
+					Access.Opaque = LinkedK2Node;
+
+				GatherInputAccess( LinkedK2Node, Access, Visited );
+			}
+		}
+	}
+}
+
+// Record the variables used by everything that executes from the loop body pin, until execution returns to the loop
+static FLoopBodyAccess GatherLoopBodyAccess( const UEdGraphPin *BodyPin, const UEdGraphNode *LoopNode )
+{
+	FLoopBodyAccess Access;
+	TSet< const UEdGraphNode* > Visited;
+	TArray< const UEdGraphNode* > Pending;
+
+	for (const auto LinkedPin : BodyPin->LinkedTo)
+		Pending.Add( LinkedPin->GetOwningNode( ) );
+
+	while (Pending.Num( ) > 0)
+	{
+		const auto Node = Pending.Pop( );
+		if ((Node == LoopNode) || Access.Nodes.Contains( Node ))
+			continue;
+
+		Access.Nodes.Add( Node );
+
+		if ((Access.Opaque == nullptr) && !IsKnownLoopBodyNode( Node ))
+			Access.Opaque = Node;
+
+		if (const auto VariableSet = Cast< UK2Node_VariableSet >( Node ))
+			Access.Writes.Add( VariableSet->GetVarName( ) );
+
+		GatherInputAccess( Node, Access, Visited );
+
+		for (const auto Pin : Node->Pins)
+		{
+			if ((Pin->Direction != EGPD_Output) || (Pin->PinType.PinCategory != UEdGraphSchema_K2::PC_Exec))
+				continue;
+
+			for (const auto LinkedPin : Pin->LinkedTo)
+				Pending.Add( LinkedPin->GetOwningNode( ) );
+		}
+	}
+
+	return Access;
+}
+
+// Find a node that the reader takes a value from which the writer's loop (or its body) produces, null if there isn't one
+static const UEdGraphNode* FindDependentNode( const FLoopBodyAccess &Writer, const UEdGraphNode *WriterLoop, const FLoopBodyAccess &Reader )
+{
+	if (Reader.Sources.Contains( WriterLoop ))
+		return WriterLoop;
+
+	for (const auto Node : Writer.Nodes)
+	{
+		if (Reader.Sources.Contains( Node ))
+			return Node;
+	}
+
+	return nullptr;
+}
+
+// Find a variable that one access writes and the other reads, NAME_None if there isn't one
+static FName FindDependentVariable( const FLoopBodyAccess &Writer, const FLoopBodyAccess &Reader )
+{
+	for (const auto &Name : Writer.Writes)
+	{
+		if (Reader.Reads.Contains( Name ))
+			return Name;
+	}
+
+	return NAME_None;
+}
+
 void UK2Node_NativeForEach::AllocateDefaultPins( )
 {
 	Super::AllocateDefaultPins( );
@@ -32,14 +199,9 @@ void UK2Node_NativeForEach::AllocateDefaultPins( )
 	// Execution pin
 	CreatePin( EGPD_Input, UEdGraphSchema_K2::PC_Exec, UEdGraphSchema_K2::PN_Execute );
 
-	const auto ArrayPin = CreatePin( EGPD_Input, UEdGraphSchema_K2::PC_Wildcard, ArrayPinName );
-	ArrayPin->PinType.ContainerType = EPinContainerType::Array;
-	ArrayPin->PinType.bIsConst = true;
-	ArrayPin->PinType.bIsReference = true;
+	const auto ArrayPin = CreatePin( EGPD_Input, CoreTechK2Utilities::GetWildcardArrayType( ), ArrayPinName );
 	ArrayPin->PinFriendlyName = LOCTEXT( "ArrayPin_FriendlyName", "Array" );
 
-	OriginalWildcardType = ArrayPin->PinType;
-
 	const auto BreakPin = CreatePin( EGPD_Input, UEdGraphSchema_K2::PC_Exec, BreakPinName );
 	BreakPin->PinFriendlyName = LOCTEXT( "BreakPin_FriendlyName", "Break" );
 	BreakPin->bAdvancedView = true;
@@ -59,17 +221,6 @@ void UK2Node_NativeForEach::AllocateDefaultPins( )
 	CompletedPin->PinFriendlyName = LOCTEXT( "CompletedPin_FriendlyName", "Completed" );
 	CompletedPin->PinToolTip = LOCTEXT( "CompletedPin_Tooltip", "Execution once all array elements have been visited" ).ToString( );
 
-	if (InputCurrentType.PinCategory == NAME_None)
-	{
-		InputCurrentType = OriginalWildcardType;
-	}
-	else if (InputCurrentType.PinCategory != UEdGraphSchema_K2::PC_Wildcard)
-	{
-		ArrayPin->PinType = InputCurrentType;
-		ElementPin->PinType = InputCurrentType;
-		ElementPin->PinType.ContainerType = EPinContainerType::None;
-	}
-
 	CoreTechK2Utilities::SetPinToolTip( ArrayPin, LOCTEXT( "ArrayPin_Tooltip", "Array to visit all elements of" ) );
 	CoreTechK2Utilities::SetPinToolTip( ElementPin, LOCTEXT( "ElementPin_Tooltip", "Element of the Array" ) );
 
@@ -77,24 +228,88 @@ void UK2Node_NativeForEach::AllocateDefaultPins( )
 		AdvancedPinDisplay = ENodeAdvancedPins::Hidden;
 }
 
+void UK2Node_NativeForEach::ReallocatePinsDuringReconstruction( TArray< UEdGraphPin* > &OldPins )
+{
+	Super::ReallocatePinsDuringReconstruction( OldPins );
+
+	if (const auto OldArrayType = CoreTechK2Utilities::GetReconstructedPinType( OldPins, ArrayPinName ))
+		SetArrayType( *OldArrayType );
+}
+
 void UK2Node_NativeForEach::PostPasteNode( )
 {
 	Super::PostPasteNode( );
 
-	InputCurrentType.PinCategory = NAME_None;
-	if (const auto ArrayPin = GetArrayPin( ))
+	if (CoreTechK2Utilities::IsPinTypeStale( GetArrayPin( ) ))
+		PinConnectionListChanged( GetArrayPin( ) );
+}
+
+void UK2Node_NativeForEach::Serialize( FArchive &Ar )
+{
+	Super::Serialize( Ar );
+
+	Ar.UsingCustomVersion( FCoreTechK2NodesVersion::GUID );
+}
+
+void UK2Node_NativeForEach::PostLoad( )
+{
+	Super::PostLoad( );
+
+	if (GetLinkerCustomVersion( FCoreTechK2NodesVersion::GUID ) < FCoreTechK2NodesVersion::CompactWildcardPinTypes)
 	{
-		if ((InputCurrentType.PinCategory == NAME_None) && ArrayPin->LinkedTo.Num( ))
+		// The saved type was the authority for older nodes, make sure the pins agree with it before discarding it
+		const auto ArrayPin = FindPin( ArrayPinName );
+		if ((ArrayPin != nullptr) && (ArrayPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Wildcard) &&
+			(InputCurrentType.PinCategory != NAME_None) && (InputCurrentType.PinCategory != UEdGraphSchema_K2::PC_Wildcard))
 		{
-			PinConnectionListChanged( ArrayPin );
+			SetArrayType( InputCurrentType );
 		}
+
+		// Back to the default value so that it's no longer written out
+		InputCurrentType = FEdGraphPinType( );
 	}
 }
 
+#if WITH_EDITOR
+void UK2Node_NativeForEach::PostEditChangeProperty( FPropertyChangedEvent &PropertyChangedEvent )
+{
+	Super::PostEditChangeProperty( PropertyChangedEvent );
+
+	bool bRefresh = false;
+
+	if (PropertyChangedEvent.GetPropertyName( ) == GET_MEMBER_NAME_CHECKED( UK2Node_NativeForEach, bProjectStructMembers ))
+	{
+		CoreTechK2Utilities::RefreshStructMemberPins( this, GetElementPin( ), bProjectStructMembers );
+		bRefresh = true;
+	}
+	else if (PropertyChangedEvent.GetPropertyName( ) == GET_MEMBER_NAME_CHECKED( UK2Node_NativeForEach, bSkipInvalidObjects ))
+	{
+		bRefresh = true;
+	}
+	else if (PropertyChangedEvent.GetPropertyName( ) == GET_MEMBER_NAME_CHECKED( UK2Node_NativeForEach, bFuseWithNextLoop ))
+	{
+		bRefresh = true;
+	}
+
+	if (bRefresh)
+	{
+		// Poke the graph to update the visuals based on the above changes
+		GetGraph( )->NotifyGraphChanged( );
+		FBlueprintEditorUtils::MarkBlueprintAsModified( GetBlueprint( ) );
+	}
+}
+#endif
+
 void UK2Node_NativeForEach::ExpandNode( FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph )
 {
 	Super::ExpandNode( CompilerContext, SourceGraph );
 
+	const auto &Plan = GetLoopFusionPlan( SourceGraph );
+
+	// A loop that is fused into the one before it gets expanded as part of that loop
+	if (Plan.FusedIntoPrevious.Contains( this ))
+		return;
+
 	if (CheckForErrors( CompilerContext ))
 	{
 		// remove all the links to this node as they are no longer needed
@@ -102,7 +317,17 @@ void UK2Node_NativeForEach::ExpandNode( FKismetCompilerContext& CompilerContext,
 		return;
 	}
 
-	const auto K2Schema = GetDefault< UEdGraphSchema_K2 >( );
+	const auto K2Schema = CompilerContext.GetSchema( );
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// The loops that directly follow this one and share its pass over the array
+	const auto FusedLoops = Plan.FusedLoops.FindRef( this );
+	for (const auto Fused : FusedLoops)
+		CompilerContext.MessageLog.Note( *LOCTEXT( "Fused_Note", "@@ was fused into the pass over the array made by @@." ).ToString( ), Fused, this );
+
+	const auto LastLoop = (FusedLoops.Num( ) > 0) ? FusedLoops.Last( ) : this;
+	if (const auto Reason = Plan.SkippedReasons.Find( LastLoop ))
+		CompilerContext.MessageLog.Note( *FText::Format( LOCTEXT( "FusionSkipped_Note", "@@ wasn't fused with the loop after it: {0}" ), *Reason ).ToString( ), LastLoop );
 
 	///////////////////////////////////////////////////////////////////////////////////
 	// Cache off versions of all our important pins
@@ -110,9 +335,10 @@ void UK2Node_NativeForEach::ExpandNode( FKismetCompilerContext& CompilerContext,
 	const auto ArrayPin = GetArrayPin( );
 
 	const auto ForEachPin = GetForEachPin( );
-	const auto ArrayElementPin = GetElementPin( );
 	const auto ArrayIndexPin = GetArrayIndexPin( );
-	const auto CompletedPin = GetCompletedPin( );
+
+	// Fused loops all complete together, once the last of them would have
+	const auto CompletedPin = (FusedLoops.Num( ) > 0) ? FusedLoops.Last( )->GetCompletedPin( ) : GetCompletedPin( );
 
 	///////////////////////////////////////////////////////////////////////////////////
 	// Create a loop counter variable
@@ -122,6 +348,8 @@ void UK2Node_NativeForEach::ExpandNode( FKismetCompilerContext& CompilerContext,
 
 	const auto Temp_Variable = CreateTemporaryVariable->GetVariablePin( );
 	CompilerContext.MovePinLinksToIntermediate( *ArrayIndexPin, *Temp_Variable );
+	for (const auto Fused : FusedLoops)
+		CompilerContext.MovePinLinksToIntermediate( *Fused->GetArrayIndexPin( ), *Temp_Variable );
 
 	///////////////////////////////////////////////////////////////////////////////////
 	// Initialize the temporary to 0
@@ -135,7 +363,34 @@ void UK2Node_NativeForEach::ExpandNode( FKismetCompilerContext& CompilerContext,
 
 	CompilerContext.MovePinLinksToIntermediate( *ExecPin, *Init_Exec );
 	K2Schema->TryCreateConnection( Init_Variable, Temp_Variable );
-	Init_Value->DefaultValue = TEXT( "0" );
+
+	// When skipping invalid elements, the counter always moves to the next valid index with a single native call
+	const bool bSkipInvalid = ShouldSkipInvalidObjects( );
+	const auto SpawnNextValidIndex = [ & ]( )
+	{
+		const auto NextValidIndex = CompilerContext.SpawnIntermediateNode< UK2Node_CallFunction >( this, SourceGraph );
+		NextValidIndex->FunctionReference.SetExternalMember( GET_FUNCTION_NAME_CHECKED( UCoreTechArrayLibrary, Array_NextValidIndex ), UCoreTechArrayLibrary::StaticClass( ) );
+		NextValidIndex->AllocateDefaultPins( );
+
+		const auto NextValid_Array = NextValidIndex->FindPinChecked( TEXT( "TargetArray" ) );
+
+		// Coerce the wildcard pin types
+		NextValid_Array->PinType = ArrayPin->PinType;
+		CompilerContext.CopyPinLinksToIntermediate( *ArrayPin, *NextValid_Array );
+
+		return NextValidIndex;
+	};
+
+	if (bSkipInvalid)
+	{
+		const auto FirstValid = SpawnNextValidIndex( );
+		FirstValid->FindPinChecked( TEXT( "StartIndex" ) )->DefaultValue = TEXT( "0" );
+		FirstValid->GetReturnValuePin( )->MakeLinkTo( Init_Value );
+	}
+	else
+	{
+		Init_Value->DefaultValue = TEXT( "0" );
+	}
 
 	///////////////////////////////////////////////////////////////////////////////////
 	// Branch on comparing the loop index with the length of the array
@@ -175,32 +430,26 @@ void UK2Node_NativeForEach::ExpandNode( FKismetCompilerContext& CompilerContext,
 	CompilerContext.CopyPinLinksToIntermediate( *ArrayPin, *ArrayLength_Array );
 
 	///////////////////////////////////////////////////////////////////////////////////
-	// Sequence the loop body and incrementing the loop counter
+	// Sequence the loop body (and the bodies of any fused loops) and incrementing the loop counter
 	const auto LoopSequence = CompilerContext.SpawnIntermediateNode< UK2Node_ExecutionSequence >( this, SourceGraph );
 	LoopSequence->AllocateDefaultPins( );
+	for (int idx = 0; idx < FusedLoops.Num( ); ++idx)
+		LoopSequence->AddInputPin( );
 
 	const auto Sequence_Exec = LoopSequence->GetExecPin( );
 	const auto Sequence_One = LoopSequence->GetThenPinGivenIndex( 0 );
-	const auto Sequence_Two = LoopSequence->GetThenPinGivenIndex( 1 );
+	const auto Sequence_Two = LoopSequence->GetThenPinGivenIndex( FusedLoops.Num( ) + 1 );
 
 	Branch_Then->MakeLinkTo( Sequence_Exec );
 	CompilerContext.MovePinLinksToIntermediate( *ForEachPin, *Sequence_One );
+	ExpandElementPins( CompilerContext, SourceGraph, ArrayPin, Temp_Variable );
 
-	const auto GetArrayElement = CompilerContext.SpawnIntermediateNode< UK2Node_CallFunction >( this, SourceGraph );
-	GetArrayElement->FunctionReference.SetExternalMember( GET_FUNCTION_NAME_CHECKED( UKismetArrayLibrary, Array_Get ), UKismetArrayLibrary::StaticClass( ) );
-	GetArrayElement->AllocateDefaultPins( );
-
-	const auto GetElement_Array = GetArrayElement->FindPinChecked( TEXT( "TargetArray" ) );
-	const auto GetElement_Index = GetArrayElement->FindPinChecked( TEXT( "Index" ) );
-	const auto GetElement_Return = GetArrayElement->FindPinChecked( TEXT( "Item" ) );
-
-	// Coerce the wildcard pin types
-	GetElement_Array->PinType = ArrayPin->PinType;
-	GetElement_Return->PinType = ArrayElementPin->PinType;
-
-	CompilerContext.CopyPinLinksToIntermediate( *ArrayPin, *GetElement_Array );
-	GetElement_Index->MakeLinkTo( Temp_Variable );
-	CompilerContext.MovePinLinksToIntermediate( *ArrayElementPin, *GetElement_Return );
+	for (int idx = 0; idx < FusedLoops.Num( ); ++idx)
+	{
+		const auto Fused = FusedLoops[ idx ];
+		CompilerContext.MovePinLinksToIntermediate( *Fused->GetForEachPin( ), *LoopSequence->GetThenPinGivenIndex( idx + 1 ) );
+		Fused->ExpandElementPins( CompilerContext, SourceGraph, ArrayPin, Temp_Variable );
+	}
 
 	///////////////////////////////////////////////////////////////////////////////////
 	// Increment the loop counter by one
@@ -226,7 +475,17 @@ void UK2Node_NativeForEach::ExpandNode( FKismetCompilerContext& CompilerContext,
 
 	Temp_Variable->MakeLinkTo( Add_A );
 	Add_B->DefaultValue = TEXT( "1" );
-	Add_Return->MakeLinkTo( Inc_Value );
+
+	if (bSkipInvalid)
+	{
+		const auto NextValid = SpawnNextValidIndex( );
+		Add_Return->MakeLinkTo( NextValid->FindPinChecked( TEXT( "StartIndex" ) ) );
+		NextValid->GetReturnValuePin( )->MakeLinkTo( Inc_Value );
+	}
+	else
+	{
+		Add_Return->MakeLinkTo( Inc_Value );
+	}
 
 	///////////////////////////////////////////////////////////////////////////////////
 	// Create a sequence from the break exec that will set the loop counter to the last array index.
@@ -257,10 +516,62 @@ void UK2Node_NativeForEach::ExpandNode( FKismetCompilerContext& CompilerContext,
 	GetIndex_Return->MakeLinkTo( Set_Value );
 
 	///////////////////////////////////////////////////////////////////////////////////
-	//
+	// The fused loops have been expanded along with this one
+	for (const auto Fused : FusedLoops)
+		Fused->BreakAllNodeLinks( );
+
 	BreakAllNodeLinks( );
 }
 
+void UK2Node_NativeForEach::ExpandElementPins( FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph, UEdGraphPin *ArrayPin, UEdGraphPin *Temp_Variable )
+{
+	const auto K2Schema = CompilerContext.GetSchema( );
+	const auto ArrayElementPin = GetElementPin( );
+
+	const auto GetArrayElement = CompilerContext.SpawnIntermediateNode< UK2Node_CallFunction >( this, SourceGraph );
+	GetArrayElement->FunctionReference.SetExternalMember( GET_FUNCTION_NAME_CHECKED( UKismetArrayLibrary, Array_Get ), UKismetArrayLibrary::StaticClass( ) );
+	GetArrayElement->AllocateDefaultPins( );
+
+	const auto GetElement_Array = GetArrayElement->FindPinChecked( TEXT( "TargetArray" ) );
+	const auto GetElement_Index = GetArrayElement->FindPinChecked( TEXT( "Index" ) );
+	const auto GetElement_Return = GetArrayElement->FindPinChecked( TEXT( "Item" ) );
+
+	// Coerce the wildcard pin types
+	GetElement_Array->PinType = ArrayPin->PinType;
+	GetElement_Return->PinType = ArrayElementPin->PinType;
+
+	CompilerContext.CopyPinLinksToIntermediate( *ArrayPin, *GetElement_Array );
+	GetElement_Index->MakeLinkTo( Temp_Variable );
+	CompilerContext.MovePinLinksToIntermediate( *ArrayElementPin, *GetElement_Return );
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// Read any projected struct members directly out of the array element
+	for (const auto Member : CoreTechK2Utilities::GetProjectableStructMembers( K2Schema, CoreTechK2Utilities::GetPinTypeStruct( ArrayElementPin->PinType ) ))
+	{
+		const auto MemberPin = FindPin( CoreTechK2Utilities::GetStructMemberPinName( ElementPinName, Member ) );
+		if ((MemberPin == nullptr) || (MemberPin->LinkedTo.Num( ) == 0))
+			continue;
+
+		const auto GetMember = CompilerContext.SpawnIntermediateNode< UK2Node_CallFunction >( this, SourceGraph );
+		GetMember->FunctionReference.SetExternalMember( GET_FUNCTION_NAME_CHECKED( UCoreTechArrayLibrary, Array_GetMember ), UCoreTechArrayLibrary::StaticClass( ) );
+		GetMember->AllocateDefaultPins( );
+
+		const auto GetMember_Array = GetMember->FindPinChecked( TEXT( "TargetArray" ) );
+		const auto GetMember_Index = GetMember->FindPinChecked( TEXT( "Index" ) );
+		const auto GetMember_Name = GetMember->FindPinChecked( TEXT( "MemberName" ) );
+		const auto GetMember_Value = GetMember->FindPinChecked( TEXT( "Value" ) );
+
+		// Coerce the wildcard pin types
+		GetMember_Array->PinType = ArrayPin->PinType;
+		GetMember_Value->PinType = MemberPin->PinType;
+
+		CompilerContext.CopyPinLinksToIntermediate( *ArrayPin, *GetMember_Array );
+		GetMember_Index->MakeLinkTo( Temp_Variable );
+		GetMember_Name->DefaultValue = Member->GetName( );
+		CompilerContext.MovePinLinksToIntermediate( *MemberPin, *GetMember_Value );
+	}
+}
+
 bool UK2Node_NativeForEach::CheckForErrors( const FKismetCompilerContext& CompilerContext )
 {
 	bool bError = false;
@@ -270,6 +581,10 @@ bool UK2Node_NativeForEach::CheckForErrors( const FKismetCompilerContext& Compil
 		CompilerContext.MessageLog.Error( *LOCTEXT( "MissingArray_Error", "For Each (Native) node @@ must have an array to iterate." ).ToString( ), this );
 		bError = true;
 	}
+	else if (bSkipInvalidObjects && !ShouldSkipInvalidObjects( ))
+	{
+		CompilerContext.MessageLog.Warning( *LOCTEXT( "SkipInvalid_Warning", "For Each (Native) node @@ can only skip invalid elements of object arrays, all elements will be visited." ).ToString( ), this );
+	}
 
 	return bError;
 }
@@ -284,19 +599,164 @@ void UK2Node_NativeForEach::PinConnectionListChanged( UEdGraphPin* Pin )
 	if (Pin->PinName == ArrayPinName)
 	{
 		if (Pin->LinkedTo.Num( ) > 0)
-			InputCurrentType = Pin->LinkedTo[ 0 ]->PinType;
+			SetArrayType( Pin->LinkedTo[ 0 ]->PinType );
 		else
-			InputCurrentType = OriginalWildcardType;
+			SetArrayType( CoreTechK2Utilities::GetWildcardArrayType( ) );
+
+		if (bProjectStructMembers)
+			GetGraph( )->NotifyGraphChanged( );
+	}
+}
 
-		Pin->PinType = InputCurrentType;
+void UK2Node_NativeForEach::SetArrayType( const FEdGraphPinType &ArrayType )
+{
+	const auto ArrayPin = GetArrayPin( );
+	ArrayPin->PinType = ArrayType;
+
+	const auto ElementPin = GetElementPin( );
+	ElementPin->PinType = ArrayType;
+	ElementPin->PinType.ContainerType = EPinContainerType::None;
+
+	CoreTechK2Utilities::SetPinToolTip( ArrayPin, LOCTEXT( "ArrayPin_Tooltip", "Array to visit all elements of" ) );
+	CoreTechK2Utilities::SetPinToolTip( ElementPin, LOCTEXT( "ElementPin_Tooltip", "Element of the Array" ) );
+
+	CoreTechK2Utilities::RefreshStructMemberPins( this, ElementPin, bProjectStructMembers );
+}
+
+UK2Node_NativeForEach* UK2Node_NativeForEach::FindFusableNextLoop( FText *OutReason ) const
+{
+	// Only plain loops are fused, anything deriving from this node adds its own behaviour to the loop
+	if (!bFuseWithNextLoop || !bCanFuseWithNextLoop)
+		return nullptr;
+
+	const auto CompletedPin = GetCompletedPin( );
+	if (CompletedPin->LinkedTo.Num( ) != 1)
+		return nullptr;
+
+	const auto Next = ExactCast< UK2Node_NativeForEach >( CompletedPin->LinkedTo[ 0 ]->GetOwningNode( ) );
+	if ((Next == nullptr) || (CompletedPin->LinkedTo[ 0 ] != Next->GetExecPin( )))
+		return nullptr;
+
+	const auto SetReason = [ OutReason ]( const FText &Reason )
+	{
+		if (OutReason != nullptr)
+			*OutReason = Reason;
+		return nullptr;
+	};
+
+	if (Next->GetExecPin( )->LinkedTo.Num( ) != 1)
+		return SetReason( LOCTEXT( "FuseExec_Reason", "the next loop is also run from somewhere else" ) );
+
+	const auto ArrayPin = GetArrayPin( );
+	const auto NextArrayPin = Next->GetArrayPin( );
+	if ((ArrayPin->LinkedTo.Num( ) != 1) || (NextArrayPin->LinkedTo.Num( ) != 1) || (ArrayPin->LinkedTo[ 0 ] != NextArrayPin->LinkedTo[ 0 ]))
+		return SetReason( LOCTEXT( "FuseArray_Reason", "the loops aren't over the same array" ) );
+
+	if ((GetBreakPin( )->LinkedTo.Num( ) > 0) || (Next->GetBreakPin( )->LinkedTo.Num( ) > 0))
+		return SetReason( LOCTEXT( "FuseBreak_Reason", "breaking out of either loop would also stop the other" ) );
+
+	if (ShouldSkipInvalidObjects( ) != Next->ShouldSkipInvalidObjects( ))
+		return SetReason( LOCTEXT( "FuseSkip_Reason", "only one of the loops skips invalid objects" ) );
+
+	// The array has to be the same one for both loops, which can only be told when it comes straight from a variable
+	const auto ArraySource = Cast< UK2Node_VariableGet >( ArrayPin->LinkedTo[ 0 ]->GetOwningNode( ) );
+	if (ArraySource == nullptr)
+		return SetReason( LOCTEXT( "FuseArraySource_Reason", "the array doesn't come directly from a variable" ) );
 
-		const auto ElementPin = GetElementPin( );
-		ElementPin->PinType = InputCurrentType;
-		ElementPin->PinType.ContainerType = EPinContainerType::None;
+	// Running the bodies interleaved is only the same as running them one after the other if neither body
+	// reads something that the other body writes. The array itself counts as being read by both.
+	auto Access = GatherLoopBodyAccess( GetForEachPin( ), this );
+	auto NextAccess = GatherLoopBodyAccess( Next->GetForEachPin( ), Next );
 
-		CoreTechK2Utilities::SetPinToolTip( Pin, LOCTEXT( "ArrayPin_Tooltip", "Array to visit all elements of" ) );
-		CoreTechK2Utilities::SetPinToolTip( ElementPin, LOCTEXT( "ElementPin_Tooltip", "Element of the Array" ) );
+	Access.Reads.Add( ArraySource->GetVarName( ) );
+	NextAccess.Reads.Add( ArraySource->GetVarName( ) );
+
+	// Anything other than variable reads and writes, plain flow control and math could use state that isn't tracked here
+	const auto Opaque = (Access.Opaque != nullptr) ? Access.Opaque : NextAccess.Opaque;
+	if (Opaque != nullptr)
+		return SetReason( FText::Format( LOCTEXT( "FuseOpaque_Reason", "'{0}' may read or change state that can't be checked" ), Opaque->GetNodeTitle( ENodeTitleType::ListView ) ) );
+
+	// Values from the other loop (its element or index, or anything its body produces) would be read mid-loop instead of after it
+	auto DependentNode = FindDependentNode( Access, this, NextAccess );
+	if (DependentNode == nullptr)
+		DependentNode = FindDependentNode( NextAccess, Next, Access );
+
+	if (DependentNode != nullptr)
+		return SetReason( FText::Format( LOCTEXT( "FuseValue_Reason", "one loop body uses a value from '{0}' in the other loop" ), DependentNode->GetNodeTitle( ENodeTitleType::ListView ) ) );
+
+	auto Dependent = FindDependentVariable( Access, NextAccess );
+	if (Dependent.IsNone( ))
+		Dependent = FindDependentVariable( NextAccess, Access );
+
+	if (!Dependent.IsNone( ))
+		return SetReason( FText::Format( LOCTEXT( "FuseData_Reason", "the loop bodies depend on each other through '{0}'" ), FText::FromName( Dependent ) ) );
+
+	return Next;
+}
+
+const FLoopFusionPlan& UK2Node_NativeForEach::GetLoopFusionPlan( const UEdGraph *Graph )
+{
+	if (const auto Existing = LoopFusionPlans.Find( Graph ))
+		return *Existing;
+
+	// Forget the plans for graphs that have finished compiling and been collected
+	for (auto It = LoopFusionPlans.CreateIterator( ); It; ++It)
+	{
+		if (!It.Key( ).IsValid( ))
+			It.RemoveCurrent( );
+	}
+
+	// Every loop in the graph is planned in this one step, before any of them has been expanded,
+	// so which loops are fused doesn't depend on the order that the loops are expanded in
+	auto &Plan = LoopFusionPlans.Add( Graph );
+
+	TMap< const UK2Node_NativeForEach*, UK2Node_NativeForEach* > NextLoops;
+	TSet< const UK2Node_NativeForEach* > FollowingLoops;
+
+	for (const auto Node : Graph->Nodes)
+	{
+		const auto Loop = Cast< UK2Node_NativeForEach >( Node );
+		if (Loop == nullptr)
+			continue;
+
+		FText Reason;
+		if (const auto Next = Loop->FindFusableNextLoop( &Reason ))
+		{
+			NextLoops.Add( Loop, Next );
+			FollowingLoops.Add( Next );
+		}
+		else if (!Reason.IsEmpty( ))
+		{
+			Plan.SkippedReasons.Add( Loop, Reason );
+		}
 	}
+
+	// Each chain is headed by a loop that doesn't follow another one, so loops that run round in a circle are never fused
+	for (const auto &Pair : NextLoops)
+	{
+		if (FollowingLoops.Contains( Pair.Key ))
+			continue;
+
+		auto &Chain = Plan.FusedLoops.Add( Pair.Key );
+		for (auto Next = Pair.Value; (Next != nullptr) && !Plan.FusedIntoPrevious.Contains( Next ); Next = NextLoops.FindRef( Next ))
+		{
+			Chain.Add( Next );
+			Plan.FusedIntoPrevious.Add( Next );
+		}
+	}
+
+	return Plan;
+}
+
+bool UK2Node_NativeForEach::ShouldSkipInvalidObjects( ) const
+{
+	if (!bSkipInvalidObjects)
+		return false;
+
+	const auto &Category = GetElementPin( )->PinType.PinCategory;
+	return (Category == UEdGraphSchema_K2::PC_Object) || (Category == UEdGraphSchema_K2::PC_Class) ||
+		(Category == UEdGraphSchema_K2::PC_SoftObject) || (Category == UEdGraphSchema_K2::PC_SoftClass) ||
+		(Category == UEdGraphSchema_K2::PC_Interface);
 }
 
 UEdGraphPin* UK2Node_NativeForEach::GetArrayPin( void ) const
@@ -336,6 +796,12 @@ FText UK2Node_NativeForEach::GetNodeTitle( ENodeTitleType::Type TitleType ) cons
 
 FText UK2Node_NativeForEach::GetTooltipText( ) const
 {
+	if (bFuseWithNextLoop)
+		return LOCTEXT( "NodeToolTip_Fuse", "Loop over each element of an array, sharing the pass over the array with the loop run on completion unless the compiler finds a reason not to (noted in the compiler results)" );
+
+	if (bSkipInvalidObjects)
+		return LOCTEXT( "NodeToolTip_SkipInvalid", "Loop over each valid object in an array, skipping null and garbage objects (soft references are only skipped when they're null or loaded as garbage)" );
+
 	return LOCTEXT( "NodeToolTip", "Loop over each element of an array" );
 }
 
@@ -5,6 +5,8 @@
 
 #include "K2Node_NativeForEach.generated.h"
 
+struct FLoopFusionPlan;
+
 UCLASS( )
 class CORETECHDEVELOPER_API UK2Node_NativeForEach : public UK2Node
 {
@@ -32,7 +34,21 @@ public:
 	UE_NODISCARD FText GetTooltipText( ) const override;
 	UE_NODISCARD FSlateIcon GetIconAndTint( FLinearColor& OutColor ) const override;
 	void PinConnectionListChanged( UEdGraphPin* Pin ) override;
+	bool ShouldShowNodeProperties( ) const override { return true; }
 	void PostPasteNode( ) override;
+	void ReallocatePinsDuringReconstruction( TArray< UEdGraphPin* > &OldPins ) override;
+
+	// Object API
+	void Serialize( FArchive &Ar ) override;
+	void PostLoad( ) override;
+#if WITH_EDITOR
+	void PostEditChangeProperty( FPropertyChangedEvent &PropertyChangedEvent ) override;
+#endif
+
+protected:
+	// Whether the loop can be fused with the next one at all, cleared by the nodes that add their own behaviour to the loop
+	UPROPERTY( Transient )
+	bool bCanFuseWithNextLoop = true;
 
 private:
 	// Pin Names
@@ -45,9 +61,36 @@ private:
 	// Determine if there is any configuration options that shouldn't be allowed
 	UE_NODISCARD bool CheckForErrors( const FKismetCompilerContext& CompilerContext );
 
-	UPROPERTY( )
-	FEdGraphPinType OriginalWildcardType;
+	// Update the types of the array and element pins
+	void SetArrayType( const FEdGraphPinType &ArrayType );
+
+	// Whether the loop should step over invalid elements instead of visiting them
+	UE_NODISCARD bool ShouldSkipInvalidObjects( ) const;
+
+	// Spawn the nodes that read the element (and any projected members) at the loop counter
+	void ExpandElementPins( FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph, UEdGraphPin *ArrayPin, UEdGraphPin *Temp_Variable );
 
+	// Find the loop run on completion of this one if it can share this loop's pass over the array, along with why not if it can't
+	UE_NODISCARD UK2Node_NativeForEach* FindFusableNextLoop( FText *OutReason = nullptr ) const;
+
+	// Find which loops of a graph being compiled are fused together, planning the whole graph in one step the first time it's asked for
+	UE_NODISCARD static const FLoopFusionPlan& GetLoopFusionPlan( const UEdGraph *Graph );
+
+	// Memory of the array type from before CompactWildcardPinTypes, only read when upgrading older nodes
 	UPROPERTY( )
 	FEdGraphPinType InputCurrentType;
+
+	// Whether struct elements should have a pin for each member that reads it directly from the array
+	UPROPERTY( EditDefaultsOnly )
+	bool bProjectStructMembers = false;
+
+	// Whether elements that are null or garbage objects should be skipped instead of visited by the loop body
+	UPROPERTY( EditDefaultsOnly )
+	bool bSkipInvalidObjects = false;
+
+	// Whether the loop connected to Completed should be run in the same pass over the array variable. Fusion is only done when both
+	// loop bodies contain nothing but variable reads and writes, flow control and math, and neither uses a variable or value the other produces.
+	// Every fusion (and the reason for each one that wasn't done) is noted in the compiler results.
+	UPROPERTY( EditDefaultsOnly, meta = (EditCondition = "bCanFuseWithNextLoop", EditConditionHides) )
+	bool bFuseWithNextLoop = false;
 };
\ No newline at end of file